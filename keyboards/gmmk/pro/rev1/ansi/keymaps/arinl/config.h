@@ -23,6 +23,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define WEAR_LEVELING_LOGICAL_SIZE 1280             //default 1024    Number of bytes “exposed” to the rest of QMK and denotes the size of the usable EEPROM.
 #define WEAR_LEVELING_BACKING_SIZE 2560             //default 2048    Number of bytes used by the wear-leveling algorithm for its underlying storage, and needs to be a multiple of the logical size.
 
+#if defined(EEPROM_BENCH_ENABLE)
+#define EECONFIG_USER_DATA_SIZE 720                 // As below, plus the EEPROM benchmark's 260 byte scratch region after the usage counters
+#elif defined(MACRO_RECORDER_ENABLE) || defined(USAGE_STATS_ENABLE)
+#define EECONFIG_USER_DATA_SIZE 460                 // Macro recorder (4 byte header + 64 recorded key edges x 4 bytes) followed by the 200 byte usage counters, fits in the spare logical EEPROM above
+#endif
+
 #define FORCE_NKRO                                            // Force n-key rollover
 
 // #undef TAP_CODE_DELAY
@@ -45,7 +51,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
     #define RGBLIGHT_VAL_STEP 17                              // The number of steps to increment the brightness by (default 17)
 
     // Startup values, when none have been set
-    #define RGB_MATRIX_DEFAULT_MODE RGB_MATRIX_SOLID_REACTIVE // Sets the default effect mode, if none has been set (was RGB_MATRIX_SOLID_COLOR)
+    #define RGB_MATRIX_DEFAULT_MODE RGB_MATRIX_CUSTOM_ARINL_SOLID_REACTIVE // Sets the default effect mode, if none has been set (was RGB_MATRIX_SOLID_REACTIVE)
     #define RGB_MATRIX_DEFAULT_HUE 24                         // Sets the default hue value, if none has been set
     #define RGB_MATRIX_DEFAULT_SAT 255                        // Sets the default saturation value, if none has been set
     #define RGB_MATRIX_DEFAULT_VAL 127                        // Sets the default brightness value, if none has been set
@@ -61,15 +67,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
     #undef ENABLE_RGB_MATRIX_BAND_PINWHEEL_SAT                // Single hue 3 blade spinning pinwheel fades sat (with white)
     //#undef ENABLE_RGB_MATRIX_BAND_PINWHEEL_VAL              // Single hue 3 blade spinning pinwheel fades brightness (with black)
     #undef ENABLE_RGB_MATRIX_BAND_SPIRAL_SAT                  // Single hue spinning spiral fades brightness (with white)
-    //#undef ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL                // Single hue spinning spiral fades brightness (with black)
+    #undef ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL                  // Single hue spinning spiral fades brightness (with black) (replaced by fixed-point ARINL_BAND_SPIRAL_VAL, users/arinl/rgb_matrix_user.inc)
     //#undef ENABLE_RGB_MATRIX_CYCLE_ALL                      // Full keyboard cycling through rainbow
     //#undef ENABLE_RGB_MATRIX_CYCLE_LEFT_RIGHT               // Full gradient moving left to right
     //#undef ENABLE_RGB_MATRIX_CYCLE_UP_DOWN                  // Full gradient scrolling top to bottom
     #undef ENABLE_RGB_MATRIX_RAINBOW_MOVING_CHEVRON           // Full gradient chevron scrolling left to right (too similar to cycle left right)
-    //#undef ENABLE_RGB_MATRIX_CYCLE_OUT_IN                   // Rainbow circles coming to center.
+    #undef ENABLE_RGB_MATRIX_CYCLE_OUT_IN                     // Rainbow circles coming to center. (replaced by fixed-point ARINL_CYCLE_OUT_IN, users/arinl/rgb_matrix_user.inc)
     #undef ENABLE_RGB_MATRIX_CYCLE_OUT_IN_DUAL                // Two Rainbow circles coming to 1/3 and 2/3 points. (seems mostly redundant with above)
     #undef ENABLE_RGB_MATRIX_CYCLE_PINWHEEL                   // Built-in cycling pinwheel (seems redundant with below)
-    //#undef ENABLE_RGB_MATRIX_CYCLE_SPIRAL                   // Full gradient spinning spiral around center of keyboard
+    #undef ENABLE_RGB_MATRIX_CYCLE_SPIRAL                     // Full gradient spinning spiral around center of keyboard (replaced by fixed-point ARINL_CYCLE_SPIRAL, users/arinl/rgb_matrix_user.inc)
     #undef ENABLE_RGB_MATRIX_RAINBOW_BEACON                   // Spinning rainbow (more distracting transitions)
     //#undef ENABLE_RGB_MATRIX_RAINBOW_PINWHEELS              // Spinning rainbow (smoother)
     #undef ENABLE_RGB_MATRIX_DUAL_BEACON                      // Two rainbows spinning around keyboard (distracting, busy)
@@ -86,15 +92,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
     //#undef ENABLE_RGB_MATRIX_DIGITAL_RAIN                   // The Matrix (has buggy side LEDs that glow red)
         //Only enabled if RGB_MATRIX_KEYPRESSES or RGB_MATRIX_KEYRELEASES is defined
     //#undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE          // Key hits shown in current hue - all other keys black
-    //#undef ENABLE_RGB_MATRIX_SOLID_REACTIVE                 // Keyboard lights up in chosen hue, key hits shown in complementary hue (try this as default?)
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE                   // Keyboard lights up in chosen hue, key hits shown in complementary hue (replaced by per-LED decay ARINL_SOLID_REACTIVE, users/arinl/rgb_matrix_user.inc)
     #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE              // Hue & value pulse around a single key hit then fades value out (Single key)
     //#undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE       // same as above but more intense (Multi-key)
     #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS             // Column and Row single current color fade (Single key)
     //#undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS      // Column and Row single color fade. (Multi-key)
     #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS             // Hue & value pulse away on the same column and row of key hit then fades (Single key)
-    //#undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS      // Hue & value pulse away on the same column and row of multi-key hit then fades
-    //#undef ENABLE_RGB_MATRIX_SPLASH                         // Full rainbow pulses from key hit. All else black.
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS        // Hue & value pulse away on the same column and row of multi-key hit then fades (replaced by fixed-point ARINL_SOLID_REACTIVE_MULTINEXUS, users/arinl/rgb_matrix_user.inc)
+    #undef ENABLE_RGB_MATRIX_SPLASH                           // Full rainbow pulses from key hit. All else black. (replaced by fixed-point ARINL_SPLASH, users/arinl/rgb_matrix_user.inc)
     #undef ENABLE_RGB_MATRIX_MULTISPLASH                      // Full rainbow pulses from multi-keys. All else black. (distracting on multiple keystroke hits)
     #undef ENABLE_RGB_MATRIX_SOLID_SPLASH                     // Single color pulses from key hit. All else black. (distracting on multiple key hits)
-    //#undef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH              // Single color pulses from muli-keys. All else black.
+    #undef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH                // Single color pulses from muli-keys. All else black. (replaced by fixed-point ARINL_SOLID_MULTISPLASH, users/arinl/rgb_matrix_user.inc)
 #endif //RGB_MATRIX_ENABLE
\ No newline at end of file
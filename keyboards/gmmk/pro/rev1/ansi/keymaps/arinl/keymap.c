@@ -24,8 +24,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "arinl.h"
 
-#include <math.h>
-
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 
     /* Base Layout
@@ -57,9 +55,9 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     [_FN1] = LAYOUT(
         EE_CLR,  _______, _______, _______, _______, _______, KC_MPRV, KC_MPLY, KC_MNXT, _______, KC_PAUS, KC_SCRL, KC_PSCR,  KC_INS,           KC_SLEP,
         _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,           _______,
-        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, QK_BOOT,           _______,
-        _______, _______, _______, _______, _______, _______, _______, _______, _______, LOCKPC,  _______, _______,          _______,           _______,
-        _______,         RGB_NITE, RGB_TOG, _______, _______, _______,  KC_NUM, _______, _______, _______, _______,          _______,  RGB_MOD, _______,
+        _______, MR_QNTZ, _______, KC_EEBN, MR_REC,  TB_SET,  _______, _______, _______, _______, MR_PLAY, TB_RATD, TB_RATU, QK_BOOT,           _______,
+        _______, _______, MR_SAVE, _______, _______, _______, _______, _______, _______, LOCKPC,  MR_FAST, MR_SLOW,          _______,           _______,
+        _______,         RGB_NITE, RGB_TOG, MC_CLSC, RGB_DUMP, RGB_BNCH, KC_NUM, MC_TUNE, MC_SPEC, KC_SOAK, KC_USAGE,          _______,  RGB_MOD, _______,
         _______, KC_WINLCK, _______,                          _______,                            _______, _______, _______, RGB_SPD, RGB_RMOD, RGB_SPI
     ),
 
@@ -91,6 +89,16 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     ),
 };
 
+#ifdef GAME_INPUT_ENABLE
+// Timed press patterns on the gaming layers (see users/arinl/arinl_gameinput.c)
+const game_input_t game_inputs[] = {
+    { _FN3, KC_J, GI_PLINK, 1 },    // SF mode: light punch re-pressed on the next frame
+    { _FN3, KC_K, GI_PLINK, 1 },    // SF mode: medium punch re-pressed on the next frame
+    { _FN4, KC_S, GI_HOLD,  2 },    // GG mode: down is always seen for at least 2 frames
+};
+const uint8_t game_inputs_count = ARRAY_SIZE(game_inputs);
+#endif // GAME_INPUT_ENABLE
+
 #if defined(ENCODER_ENABLE) && !defined(ENCODER_DEFAULTACTIONS_ENABLE) // Encoder Functionality when not using userspace defaults
 // https://docs.qmk.fm/features/encoders#callbacks encoder_update_user()
 bool encoder_update_user(uint8_t index, bool clockwise) {
@@ -103,6 +111,8 @@ bool encoder_update_user(uint8_t index, bool clockwise) {
         encoder_action_rgb_hue(clockwise);
     } else if (mods_state & MOD_BIT(KC_RALT)) {     // if holding LAlt, change rgb brightness
         encoder_action_rgb_brightness(clockwise);
+    } else if (is_macro_tuning()) {                 // in macro tuning mode, change the selected macro's step delay
+        macro_delay_update(get_tuned_macro(), clockwise);
     } else {                                        // default action changes volume, unless on _FN1 layer
         switch (get_highest_layer(layer_state)) {
         case _FN1:
@@ -121,123 +131,216 @@ bool encoder_update_user(uint8_t index, bool clockwise) {
 
 #ifdef RGB_MATRIX_ENABLE
 
-// RGB matrix setup
-bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
-    // Nightmode RGB setup
-    if (get_rgb_nightmode()) rgb_matrix_set_color_all(RGB_OFF);
+// LEDs of the KC_MCRO1-4 keys on _FN4, used by the macro tuning indicator
+const uint8_t LED_LIST_MACROS[] = {
+    LED_COMM,
+    LED_N,
+    LED_M,
+    LED_U
+};
+
+// Indicator overlay, rebuilt from the indicator state word and replayed on top of the effect every frame
+#define INDICATOR_OVERLAY_MAX 64
+
+typedef struct {
+    uint8_t led;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+} indicator_overlay_t;
+
+static indicator_overlay_t indicator_overlay[INDICATOR_OVERLAY_MAX];
+static uint8_t indicator_overlay_count = 0;
+static uint32_t indicator_overlay_sum = 0;  // channel sum of the overlay, for the power limiter
+static uint32_t indicator_overlay_state;
+static bool indicator_overlay_valid = false;
+
+// A LED added twice keeps one entry with the last color, so the overlay covers each LED once
+static void indicator_add(uint8_t led, uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < indicator_overlay_count; i++) {
+        indicator_overlay_t *overlay = &indicator_overlay[i];
+        if (overlay->led != led) continue;
+        indicator_overlay_sum += red + green + blue - (overlay->red + overlay->green + overlay->blue);
+        *overlay = (indicator_overlay_t){ led, red, green, blue };
+        return;
+    }
+    if (indicator_overlay_count < INDICATOR_OVERLAY_MAX) {
+        indicator_overlay[indicator_overlay_count++] = (indicator_overlay_t){ led, red, green, blue };
+        indicator_overlay_sum += red + green + blue;
+    }
+}
 
-    led_t led_state = host_keyboard_led_state();
+// Shows 0 to 139 using F row (tens) and num row (ones); larger numbers light the last 3 num row keys
+static void indicator_show_number(uint16_t value, uint8_t red, uint8_t green, uint8_t blue) {
+    if (value <= 10) indicator_add(LED_LIST_FUNCROW[value], red, green, blue);
+    else if (value < 140) {
+        indicator_add(LED_LIST_FUNCROW[(value / 10)], red, green, blue);
+        indicator_add(LED_LIST_NUMROW[(value % 10)], red, green, blue);
+    } else { // >= 140, just show these 3 lights
+        indicator_add(LED_LIST_NUMROW[10], red, green, blue);
+        indicator_add(LED_LIST_NUMROW[11], red, green, blue);
+        indicator_add(LED_LIST_NUMROW[12], red, green, blue);
+    }
+}
+
+// Works out the indicator overlay for one indicator state, only runs when that state changes
+static void indicators_build(uint32_t state) {
     // ScrollLock RGB setup
-    if (led_state.scroll_lock) { 
-        rgb_matrix_set_color(LED_F11, RGB_RED);
+    if (state & IND_SCROLL_LOCK) { 
+        indicator_add(LED_F11, RGB_RED);
     }
 
     // NumLock RGB setup
     #ifdef INVERT_NUMLOCK_INDICATOR
-    if (!led_state.num_lock) { // on if NUM lock is OFF
-        rgb_matrix_set_color(LED_N, RGB_ORANGE2);
-        rgb_matrix_set_color(LED_FN, RGB_ORANGE2);
+    if (!(state & IND_NUM_LOCK)) { // on if NUM lock is OFF
+        indicator_add(LED_N, RGB_ORANGE2);
+        indicator_add(LED_FN, RGB_ORANGE2);
     }
     #else
-    if (led_state.num_lock) { // Normal, on if NUM lock is ON
-        rgb_matrix_set_color(LED_N, RGB_ORANGE2);
-        rgb_matrix_set_color(LED_FN, RGB_ORANGE2);
+    if (state & IND_NUM_LOCK) { // Normal, on if NUM lock is ON
+        indicator_add(LED_N, RGB_ORANGE2);
+        indicator_add(LED_FN, RGB_ORANGE2);
     }
     #endif // INVERT_NUMLOCK_INDICATOR
 
     // CapsLock RGB setup
-    if (led_state.caps_lock) {
-        rgb_matrix_set_color(LED_L6, RGB_WHITE);
-        rgb_matrix_set_color(LED_L7, RGB_WHITE);
-        rgb_matrix_set_color(LED_L8, RGB_WHITE);
-        rgb_matrix_set_color(LED_CAPS, RGB_WHITE);
+    if (state & IND_CAPS_LOCK) {
+        indicator_add(LED_L6, RGB_WHITE);
+        indicator_add(LED_L7, RGB_WHITE);
+        indicator_add(LED_L8, RGB_WHITE);
+        indicator_add(LED_CAPS, RGB_WHITE);
+    }
+
+    // Macro recorder RGB setup
+    if (state & IND_RECORDING) {
+        indicator_add(LED_ESC, RGB_RED);
+    } else if (state & IND_PLAYING) {
+        indicator_add(LED_ESC, RGB_GREEN);
     }
 
     // Winkey RGB setup
-    if (keymap_config.no_gui) {
-        rgb_matrix_set_color(LED_LWIN, RGB_RED); // RGB_RED when Winkey disabled
+    if (state & IND_WINLOCK) {
+        indicator_add(LED_LWIN, RGB_RED); // RGB_RED when Winkey disabled
     }
 
     // Fn selector mode RGB setup
-    switch (get_highest_layer(layer_state)) { // Handle layer RGB states
+    switch ((state & IND_LAYER_MASK) >> IND_LAYER_SHIFT) { // Handle layer RGB states
     case _FN1: 
-        rgb_matrix_set_color(LED_F6, RGB_RED);
-        rgb_matrix_set_color(LED_F7, RGB_RED);
-        rgb_matrix_set_color(LED_F8, RGB_RED);
-
-        rgb_matrix_set_color(LED_F10, RGB_YELLOW2);
-        rgb_matrix_set_color(LED_F11, RGB_YELLOW2);
-        rgb_matrix_set_color(LED_F12, RGB_YELLOW2);
-        rgb_matrix_set_color(LED_INS, RGB_YELLOW2);
-
-        rgb_matrix_set_color(LED_FN, RGB_OFFBLUE);
-
-        rgb_matrix_set_color(LED_LWIN, RGB_RED);
-        rgb_matrix_set_color(LED_BSLS, RGB_RED);
-
-        rgb_matrix_set_color(LED_N, RGB_ORANGE2);
-
-        rgb_matrix_set_color(LED_RALT, RGB_RED);
-        rgb_matrix_set_color(LED_RCTL, RGB_GREEN);
-        rgb_matrix_set_color(LED_RSFT, RGB_BLUE);
-
-        rgb_matrix_set_color(LED_Z, RGB_PURPLE2);
-        rgb_matrix_set_color(LED_X, RGB_PURPLE2);
-        rgb_matrix_set_color(LED_UP, RGB_GREEN);
-        rgb_matrix_set_color(LED_DOWN, RGB_GREEN);
-        rgb_matrix_set_color(LED_LEFT, RGB_BLUE);
-        rgb_matrix_set_color(LED_RIGHT, RGB_BLUE);
-
-        // RGB Timeout Indicator -- shows 0 to 139 using F row and num row; larger numbers using 16bit code
-        uint16_t timeout_threshold = get_timeout_threshold();
-        if (timeout_threshold <= 10) rgb_matrix_set_color(LED_LIST_FUNCROW[timeout_threshold], RGB_CYAN);
-        else if (timeout_threshold < 140) {
-            rgb_matrix_set_color(LED_LIST_FUNCROW[(timeout_threshold / 10)], RGB_CYAN);
-            rgb_matrix_set_color(LED_LIST_NUMROW[(timeout_threshold % 10)], RGB_CYAN);
-        } else { // >= 140 minutes, just show these 3 lights
-            rgb_matrix_set_color(LED_LIST_NUMROW[10], RGB_CYAN);
-            rgb_matrix_set_color(LED_LIST_NUMROW[11], RGB_CYAN);
-            rgb_matrix_set_color(LED_LIST_NUMROW[12], RGB_CYAN);
-        }
+        indicator_add(LED_F6, RGB_RED);
+        indicator_add(LED_F7, RGB_RED);
+        indicator_add(LED_F8, RGB_RED);
+
+        indicator_add(LED_F10, RGB_YELLOW2);
+        indicator_add(LED_F11, RGB_YELLOW2);
+        indicator_add(LED_F12, RGB_YELLOW2);
+        indicator_add(LED_INS, RGB_YELLOW2);
+
+        indicator_add(LED_FN, RGB_OFFBLUE);
+
+        indicator_add(LED_LWIN, RGB_RED);
+        indicator_add(LED_BSLS, RGB_RED);
+
+        indicator_add(LED_N, RGB_ORANGE2);
+
+        indicator_add(LED_RALT, RGB_RED);
+        indicator_add(LED_RCTL, RGB_GREEN);
+        indicator_add(LED_RSFT, RGB_BLUE);
+
+        indicator_add(LED_Z, RGB_PURPLE2);
+        indicator_add(LED_X, RGB_PURPLE2);
+        indicator_add(LED_UP, RGB_GREEN);
+        indicator_add(LED_DOWN, RGB_GREEN);
+        indicator_add(LED_LEFT, RGB_BLUE);
+        indicator_add(LED_RIGHT, RGB_BLUE);
+
+        // RGB Timeout Indicator -- shows 0 to 139 using F row and num row
+        #ifdef IDLE_TIMEOUT_ENABLE
+        indicator_show_number(get_timeout_threshold(), RGB_CYAN);
+        #endif
 
         // SIDE LEDS
-        rgb_matrix_set_color(LED_L7, RGB_PURPLE2);
-        rgb_matrix_set_color(LED_L8, RGB_PURPLE2);
-        rgb_matrix_set_color(LED_R7, RGB_PURPLE2);
-        rgb_matrix_set_color(LED_R8, RGB_PURPLE2);
+        indicator_add(LED_L7, RGB_PURPLE2);
+        indicator_add(LED_L8, RGB_PURPLE2);
+        indicator_add(LED_R7, RGB_PURPLE2);
+        indicator_add(LED_R8, RGB_PURPLE2);
         break;
 
     case _FN2: // Numpad overlay RGB
         for (uint8_t i = 0; i < ARRAY_SIZE(LED_LIST_NUMPAD); i++) {
-            rgb_matrix_set_color(LED_LIST_NUMPAD[i], RGB_OFFBLUE);
+            indicator_add(LED_LIST_NUMPAD[i], RGB_OFFBLUE);
         }
         // SIDE LEDS
-        rgb_matrix_set_color(LED_L5, RGB_PURPLE2);
-        rgb_matrix_set_color(LED_L6, RGB_PURPLE2);
-        rgb_matrix_set_color(LED_R5, RGB_PURPLE2);
-        rgb_matrix_set_color(LED_R6, RGB_PURPLE2);
+        indicator_add(LED_L5, RGB_PURPLE2);
+        indicator_add(LED_L6, RGB_PURPLE2);
+        indicator_add(LED_R5, RGB_PURPLE2);
+        indicator_add(LED_R6, RGB_PURPLE2);
 
         break;
 
     case _FN3: // SF mode RGB
         // SIDE LEDS
-        rgb_matrix_set_color(LED_L3, RGB_ORANGE2);
-        rgb_matrix_set_color(LED_L4, RGB_ORANGE2);
-        rgb_matrix_set_color(LED_R3, RGB_ORANGE2);
-        rgb_matrix_set_color(LED_R4, RGB_ORANGE2);
+        indicator_add(LED_L3, RGB_ORANGE2);
+        indicator_add(LED_L4, RGB_ORANGE2);
+        indicator_add(LED_R3, RGB_ORANGE2);
+        indicator_add(LED_R4, RGB_ORANGE2);
         break;
 
     case _FN4: // GG mode RGB
         // SIDE LEDS
-        rgb_matrix_set_color(LED_L1, RGB_DKRED);
-        rgb_matrix_set_color(LED_L2, RGB_DKRED);
-        rgb_matrix_set_color(LED_R1, RGB_DKRED);
-        rgb_matrix_set_color(LED_R2, RGB_DKRED);
+        indicator_add(LED_L1, RGB_DKRED);
+        indicator_add(LED_L2, RGB_DKRED);
+        indicator_add(LED_R1, RGB_DKRED);
+        indicator_add(LED_R2, RGB_DKRED);
         break;
 
     default:
         break;
     }
+
+    // Macro tuning RGB setup -- step delay (ms) of the selected macro on F row and num row
+    if (state & IND_TUNING) {
+        indicator_show_number(get_macro_delay(get_tuned_macro()), RGB_MAGENTA);
+        indicator_add(LED_LIST_MACROS[get_tuned_macro()], RGB_MAGENTA);
+    }
+}
+
+// RGB matrix setup
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    #ifdef RGB_BENCH_ENABLE
+    if (!rgb_bench_frame(led_min, led_max)) return false; // benchmark measures the bare effect
+    #endif
+
+    uint32_t state = get_indicator_state();
+    if (!indicator_overlay_valid || state != indicator_overlay_state) {
+        indicator_overlay_count = 0;
+        indicator_overlay_sum = 0;
+        indicators_build(state);
+        indicator_overlay_state = state;
+        indicator_overlay_valid = true;
+    }
+
+    #ifdef RGB_FRAME_DUMP_ENABLE
+    frame_dump_begin(led_min, led_max);
+    #endif
+    // Nightmode RGB setup
+    if (state & IND_NIGHTMODE) rgb_matrix_set_color_all(RGB_OFF);
+
+    for (uint8_t i = 0; i < indicator_overlay_count; i++) {
+        const indicator_overlay_t *overlay = &indicator_overlay[i];
+        #ifdef RGB_POWER_LIMIT_ENABLE
+        rgb_matrix_set_color(overlay->led, rgb_power_scale8(overlay->red), rgb_power_scale8(overlay->green), rgb_power_scale8(overlay->blue));
+        #else
+        rgb_matrix_set_color(overlay->led, overlay->red, overlay->green, overlay->blue);
+        #endif
+    }
+
+    #ifdef RGB_POWER_LIMIT_ENABLE
+    if (led_max >= RGB_MATRIX_LED_COUNT) rgb_power_frame_end(indicator_overlay_sum, indicator_overlay_count, !(state & IND_NIGHTMODE));
+    #endif
+
+    #ifdef RGB_FRAME_DUMP_ENABLE
+    frame_dump_end(led_min, led_max);
+    #endif
     return false;
 }
 #endif
@@ -9,4 +9,16 @@ IDLE_TIMEOUT_ENABLE = yes				# enables idle timeout of RGB
 ENCODER_DEFAULTACTIONS_ENABLE = no		# encoder default actions
 
 STARTUP_NUMLOCK_ON = no					# default numlock behavior
-INVERT_NUMLOCK_INDICATOR = no			# invert numlock rgb indicator
\ No newline at end of file
+INVERT_NUMLOCK_INDICATOR = no			# invert numlock rgb indicator
+
+TURBO_ENABLE = yes						# per-key turbo on the gaming layers (Fn + T to mark keys)
+GAME_INPUT_ENABLE = yes					# plink / minimum hold press patterns on the gaming layers
+MACRO_RECORDER_ENABLE = yes				# timed macro recorder (Fn + R record, Fn + P play, Fn + ; / ' replay faster / slower, Fn + Q quantize, Fn + S save)
+RGB_BENCH_ENABLE = no					# RGB effect CPU cost benchmark (Fn + B), needs CONSOLE_ENABLE to read the results; flash per effect: users/arinl/rgb_effect_sizes.sh
+RGB_GOVERNOR_ENABLE = yes				# static RGB frame while gaming or hammering keys, animation returns when quiet
+RGB_MATRIX_CUSTOM_USER = yes			# fixed-point userspace effects (users/arinl/rgb_matrix_user.inc)
+RGB_FRAME_DUMP_ENABLE = no				# print effect and indicator frames with their render time to the console (Fn + V), needs CONSOLE_ENABLE
+RGB_POWER_LIMIT_ENABLE = yes			# dim RGB only when a frame would draw more than the LED current budget
+SOAK_TEST_ENABLE = no					# randomized key pipeline soak test (Fn + ., volume run with shift), needs CONSOLE_ENABLE
+USAGE_STATS_ENABLE = yes				# per-key press and per-layer time counters, saved when idle, printed with Fn + / (needs CONSOLE_ENABLE)
+EEPROM_BENCH_ENABLE = no				# EEPROM write stall and compaction benchmark (Fn + E), needs CONSOLE_ENABLE
\ No newline at end of file
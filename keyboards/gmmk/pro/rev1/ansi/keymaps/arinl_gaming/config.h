@@ -0,0 +1,83 @@
+/* Copyright 2021 Jonavin Eng @Jonavin
+   Copyright 2024 arinl <arinl@tuta.io>
+   
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Competition build, see rules.mk. EEPROM layout matches the arinl keymap so switching images keeps the settings.
+#define WEAR_LEVELING_LOGICAL_SIZE 1280             //default 1024    Number of bytes “exposed” to the rest of QMK and denotes the size of the usable EEPROM.
+#define WEAR_LEVELING_BACKING_SIZE 2560             //default 2048    Number of bytes used by the wear-leveling algorithm for its underlying storage, and needs to be a multiple of the logical size.
+#define EECONFIG_USER_DATA_SIZE 460                 // Unused here, reserved so the arinl keymap's saved macro recording and usage counters survive a round trip
+
+#define FORCE_NKRO                                            // Force n-key rollover
+#define DEBOUNCE 8                                            // Same hold-off as the full build, but sym_eager_pk reports the first edge at once
+#define MACRO_SPECULATE_DISABLE                               // sym_eager_pk already reports the raw edge, no speculative start and no raw scan
+
+#ifdef RGB_MATRIX_ENABLE
+    #define RGB_DISABLE_WHEN_USB_SUSPENDED
+    // No RGB_MATRIX_KEYPRESSES and no RGB_MATRIX_FRAMEBUFFER_EFFECTS: no hit tracker, no frame buffer
+
+    // Startup values, when none have been set
+    #define RGB_MATRIX_DEFAULT_MODE RGB_MATRIX_SOLID_COLOR    // The only effect compiled in
+    #define RGB_MATRIX_DEFAULT_HUE 24                         // Sets the default hue value, if none has been set
+    #define RGB_MATRIX_DEFAULT_SAT 255                        // Sets the default saturation value, if none has been set
+    #define RGB_MATRIX_DEFAULT_VAL 127                        // Sets the default brightness value, if none has been set
+
+    // Every animated effect enabled in keyboards/gmmk/pro/config.h is turned off, solid color stays
+    #undef ENABLE_RGB_MATRIX_ALPHAS_MODS
+    #undef ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
+    #undef ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+    #undef ENABLE_RGB_MATRIX_BREATHING
+    #undef ENABLE_RGB_MATRIX_BAND_SAT
+    #undef ENABLE_RGB_MATRIX_BAND_VAL
+    #undef ENABLE_RGB_MATRIX_BAND_PINWHEEL_SAT
+    #undef ENABLE_RGB_MATRIX_BAND_PINWHEEL_VAL
+    #undef ENABLE_RGB_MATRIX_BAND_SPIRAL_SAT
+    #undef ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL
+    #undef ENABLE_RGB_MATRIX_CYCLE_ALL
+    #undef ENABLE_RGB_MATRIX_CYCLE_LEFT_RIGHT
+    #undef ENABLE_RGB_MATRIX_CYCLE_UP_DOWN
+    #undef ENABLE_RGB_MATRIX_RAINBOW_MOVING_CHEVRON
+    #undef ENABLE_RGB_MATRIX_CYCLE_OUT_IN
+    #undef ENABLE_RGB_MATRIX_CYCLE_OUT_IN_DUAL
+    #undef ENABLE_RGB_MATRIX_CYCLE_PINWHEEL
+    #undef ENABLE_RGB_MATRIX_CYCLE_SPIRAL
+    #undef ENABLE_RGB_MATRIX_RAINBOW_BEACON
+    #undef ENABLE_RGB_MATRIX_RAINBOW_PINWHEELS
+    #undef ENABLE_RGB_MATRIX_DUAL_BEACON
+    #undef ENABLE_RGB_MATRIX_RAINDROPS
+    #undef ENABLE_RGB_MATRIX_JELLYBEAN_RAINDROPS
+    #undef ENABLE_RGB_MATRIX_HUE_BREATHING
+    #undef ENABLE_RGB_MATRIX_HUE_PENDULUM
+    #undef ENABLE_RGB_MATRIX_HUE_WAVE
+    #undef ENABLE_RGB_MATRIX_PIXEL_RAIN
+    #undef ENABLE_RGB_MATRIX_PIXEL_FLOW
+    #undef ENABLE_RGB_MATRIX_PIXEL_FRACTAL
+    #undef ENABLE_RGB_MATRIX_TYPING_HEATMAP
+    #undef ENABLE_RGB_MATRIX_DIGITAL_RAIN
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS
+    #undef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
+    #undef ENABLE_RGB_MATRIX_SPLASH
+    #undef ENABLE_RGB_MATRIX_MULTISPLASH
+    #undef ENABLE_RGB_MATRIX_SOLID_SPLASH
+    #undef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
+#endif //RGB_MATRIX_ENABLE
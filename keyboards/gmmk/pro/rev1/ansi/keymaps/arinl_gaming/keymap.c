@@ -0,0 +1,148 @@
+/* Copyright 2021 Glorious, LLC <salman@pcgamingrace.com>
+   Copyright 2021 Jonavin Eng @Jonavin
+   Copyright 2024 arinl <arinl@tuta.io>
+   
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Competition build of the arinl keymap: same layers and macros, without the RGB effects, recorder, turbo and
+// the other extras. Everything shared lives in /users/arinl, see rules.mk here for what is left out and why.
+
+#include QMK_KEYBOARD_H
+
+#include "rgb_matrix_map.h"
+
+#include "arinl.h"
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+
+    /* Base Layout
+     *
+     * ,-------------------------------------------------------------------------------------------------------------.
+     * | Esc  ||  F1  |  F2  |  F3  |  F4  ||  F5  |  F6  |  F7  |  F8  ||  F9  | F10  | F11  | F12  || Del  || Mute |
+     * |=============================================================================================================|
+     * |  ` ~ |  1 ! |  2 @ |  3 # |  4 $ |  5 % |  6 ^ |  7 & |  8 * |  9 ( |  0 ) |  - _ |  = + |  Backspc || Home |
+     * |------+------+------+------+------+------+------+------+------+------+------+------+------+----------++------|
+     * |   Tab   |  Q   |  W   |  E   |  R   |  T   |  Y   |  U   |  I   |  O   |  P   | [ }  | ] }  |  \ |  || PgUp |
+     * |---------+------+------+------+------+------+------+------+------+------+------+------+------+-------++------|
+     * |  Capslock  |  A   |  S   |  D   |  F  |  G   |  H   |  J   |  K   |  L   | ; :  | ' "  |    Enter   || PgDn |
+     * |------------+------+------+------+-----+------+------+------+------+------+------+------|----+========+------|
+     * |    LShift    |  Z   |  X   |  C   |  V   |  B   |  N   |  M   | , <  | . >  | / ?  | RShift ||  Up  || End  |
+     * |--------------+------+------+------+------+------+------+------+------+------+------+--+=====++------++======|
+     * |  Ctrl  |   Win  |  LAlt  |               Space                  | RAlt |  Fn  | Ctrl || Left | Down || Rght |
+     * `-------------------------------------------------------------------------------------------------------------'
+     */
+
+    [_BASE] = LAYOUT(
+        KC_ESC,  KC_F1,   KC_F2,   KC_F3,   KC_F4,   KC_F5,   KC_F6,   KC_F7,   KC_F8,   KC_F9,   KC_F10,  KC_F11,  KC_F12,  KC_DEL,           KC_MUTE,
+        KC_GRV,  KC_1,    KC_2,    KC_3,    KC_4,    KC_5,    KC_6,    KC_7,    KC_8,    KC_9,    KC_0,    KC_MINS, KC_EQL,  KC_BSPC,          KC_HOME,
+        KC_TAB,  KC_Q,    KC_W,    KC_E,    KC_R,    KC_T,    KC_Y,    KC_U,    KC_I,    KC_O,    KC_P,    KC_LBRC, KC_RBRC, KC_BSLS,          KC_PGUP,
+        KC_CAPS,          KC_A, KC_S, KC_D, KC_F,    KC_G,    KC_H,    KC_J,    KC_K,    KC_L,    KC_SCLN, KC_QUOT,          KC_ENT,           KC_PGDN,
+        KC_LSFT,          KC_Z,    KC_X,    KC_C,    KC_V,    KC_B,    KC_N,    KC_M,    KC_COMM, KC_DOT,  KC_SLSH,          KC_RSFT, KC_UP,   KC_END,
+        KC_LCTL, KC_LGUI, KC_LALT,                            KC_SPC,                             KC_RALT, MO(_FN1),KC_RCTL, KC_LEFT, KC_DOWN, KC_RGHT
+    ),
+
+    [_FN1] = LAYOUT(
+        EE_CLR,  _______, _______, _______, _______, _______, KC_MPRV, KC_MPLY, KC_MNXT, _______, KC_PAUS, KC_SCRL, KC_PSCR,  KC_INS,           KC_SLEP,
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,           _______,
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, QK_BOOT,           _______,
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, LOCKPC,  _______, _______,          _______,           _______,
+        _______,         RGB_NITE, RGB_TOG, MC_CLSC, _______, _______, KC_NUM, MC_TUNE, MC_SPEC, _______, _______,          _______,  _______, _______,
+        _______, KC_WINLCK, _______,                          _______,                            _______, _______, _______, _______, _______, _______
+    ),
+
+    [_FN2] = LAYOUT(
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______,   KC_P7,   KC_P8, KC_P9,   _______, KC_PMNS, KC_PPLS, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______,   KC_P4,   KC_P5, KC_P6,   _______, _______, _______, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______,   KC_P1,   KC_P2, KC_P3,   _______, _______,          _______,          _______,
+        _______,          _______, _______, _______, _______, _______, _______,   KC_P0, _______, _______, _______,          _______, _______, _______,
+        _______, _______, _______,                            _______,                            _______, _______, _______, _______, _______, _______
+    ),
+
+    [_FN3] = LAYOUT(
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, KC_0,    _______,          _______,          _______,
+        _______,          _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,          _______, _______, _______,
+        _______, _______, _______,                               KC_W,                            _______, _______, _______, _______, _______, _______
+    ),
+    
+    [_FN4] = LAYOUT(
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______, KC_MCRO4,_______, _______, _______, _______, _______, _______,          _______,
+        _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______, _______,          _______,          _______,
+        _______,          _______, _______, _______, _______, _______, KC_MCRO2,KC_MCRO3,KC_MCRO1,_______, _______,          _______, _______, _______,
+        _______, _______, _______,                            _______,                            _______, _______, _______, _______, _______, _______
+    ),
+};
+
+#if defined(ENCODER_ENABLE) && !defined(ENCODER_DEFAULTACTIONS_ENABLE) // Encoder Functionality when not using userspace defaults
+// https://docs.qmk.fm/features/encoders#callbacks encoder_update_user()
+bool encoder_update_user(uint8_t index, bool clockwise) {
+    if (get_mods() & MOD_BIT(KC_LSFT)) {            // if holding Lshift, change layers (the only way to _FN2-_FN4)
+        encoder_action_layerchange(clockwise);
+    } else if (is_macro_tuning()) {                 // in macro tuning mode, change the selected macro's step delay
+        macro_delay_update(get_tuned_macro(), clockwise);
+    } else {
+        encoder_action_volume(clockwise);           // changes volume
+    }
+    return false;
+}
+#endif // ENCODER_ENABLE && !ENCODER_DEFAULTACTIONS_ENABLE
+
+#ifdef RGB_MATRIX_ENABLE
+
+// LEDs of the KC_MCRO1-4 keys on _FN4, used by the macro tuning indicator
+const uint8_t LED_LIST_MACROS[] = {
+    LED_COMM,
+    LED_N,
+    LED_M,
+    LED_U
+};
+
+// Static overlay on top of the solid color: lock keys, win lock, layer side LEDs and the macro being tuned.
+// Reads only the userspace indicator state word, nothing is asked of the host or the layer stack per frame.
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    uint32_t state = get_indicator_state();
+
+    if (state & IND_NIGHTMODE) rgb_matrix_set_color_all(RGB_OFF);
+    if (state & IND_CAPS_LOCK) rgb_matrix_set_color(LED_CAPS, RGB_WHITE);
+    if (state & IND_NUM_LOCK) rgb_matrix_set_color(LED_FN, RGB_ORANGE2);
+    if (state & IND_WINLOCK) rgb_matrix_set_color(LED_LWIN, RGB_RED);
+
+    switch ((state & IND_LAYER_MASK) >> IND_LAYER_SHIFT) {
+    case _FN1:
+        rgb_matrix_set_color(LED_FN, RGB_OFFBLUE);
+        break;
+    case _FN2:
+        rgb_matrix_set_color(LED_L5, RGB_PURPLE2);
+        rgb_matrix_set_color(LED_R5, RGB_PURPLE2);
+        break;
+    case _FN3: // SF mode
+        rgb_matrix_set_color(LED_L3, RGB_ORANGE2);
+        rgb_matrix_set_color(LED_R3, RGB_ORANGE2);
+        break;
+    case _FN4: // GG mode
+        rgb_matrix_set_color(LED_L1, RGB_DKRED);
+        rgb_matrix_set_color(LED_R1, RGB_DKRED);
+        break;
+    }
+
+    if (state & IND_TUNING) rgb_matrix_set_color(LED_LIST_MACROS[get_tuned_macro()], RGB_MAGENTA);
+    return false;
+}
+#endif // RGB_MATRIX_ENABLE
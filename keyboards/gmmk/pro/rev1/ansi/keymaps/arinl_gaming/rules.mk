@@ -0,0 +1,26 @@
+# Competition build of the arinl keymap, sharing users/arinl: qmk compile -kb gmmk/pro/rev1/ansi -km arinl_gaming
+# Keeps the macro engine, eager per-key debounce, NKRO and a static indicator overlay on a solid color. Drops the
+# animated and reactive RGB effects (and their hit tracker and frame buffer), Bootmagic, the idle timeout, turbo,
+# game inputs, the macro recorder and the RGB tools. Speculative macro starts are off: with eager debounce the
+# press already arrives on the raw edge.
+# No size or scan rate numbers are recorded for this build yet, it is leaner, not measured faster. To compare it
+# with the full build:
+#   size       qmk compile prints the firmware size and the flash left for both -km arinl and -km arinl_gaming
+#   scan rate  set CONSOLE_ENABLE = yes and add #define DEBUG_MATRIX_SCAN_RATE to config.h in both keymaps, then
+#              read the scans per second that qmk console prints once a second with the board idle and while typing
+USER_NAME := arinl
+
+LTO_ENABLE = yes						# link time optimization -- achieves a smaller compiled size
+CONSOLE_ENABLE = no						# connect to keyboard consoles to get debugging messages - https://docs.qmk.fm/cli_commands#qmk-console
+COMMAND_ENABLE = no						# change keyboards behavior without having to flash - https://docs.qmk.fm/features/command
+
+VIA_ENABLE = no							# VIA compatibility - https://www.caniusevia.com/docs/configuring_qmk
+BOOTMAGIC_ENABLE = no					# no bootloader key at plug-in, use Fn + \ (QK_BOOT)
+NKRO_ENABLE = yes						# n-key rollover, forced on in config.h
+DEBOUNCE_TYPE = sym_eager_pk			# per-key eager debounce -- a press is reported on its first edge
+
+IDLE_TIMEOUT_ENABLE = no				# enables idle timeout of RGB
+ENCODER_DEFAULTACTIONS_ENABLE = no		# encoder default actions
+
+STARTUP_NUMLOCK_ON = no					# default numlock behavior
+INVERT_NUMLOCK_INDICATOR = no			# invert numlock rgb indicator
\ No newline at end of file
@@ -19,6 +19,35 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "arinl.h"
 
+// INDICATOR STATE
+static uint32_t indicator_state = 0;
+
+uint32_t get_indicator_state(void) {
+    return indicator_state;
+}
+
+void indicator_state_set(uint32_t bits, bool on) {
+    if (on) {
+        indicator_state |= bits;
+    } else {
+        indicator_state &= ~bits;
+    }
+}
+
+// The timeout or macro delay readout changed value
+void indicator_state_touch(void) {
+    indicator_state += IND_SERIAL_ONE;
+}
+
+bool led_update_user(led_t led_state) {
+    indicator_state_set(IND_NUM_LOCK, led_state.num_lock);
+    indicator_state_set(IND_CAPS_LOCK, led_state.caps_lock);
+    indicator_state_set(IND_SCROLL_LOCK, led_state.scroll_lock);
+    boot_led_update(led_state);
+    numlock_led_update(led_state);
+    return true;
+}
+
 // RGB NIGHT MODE
 #ifdef RGB_MATRIX_ENABLE
 static bool rgb_nightmode = false;
@@ -28,6 +57,7 @@ void activate_rgb_nightmode(bool turn_on) {
     if (rgb_nightmode != turn_on) {
         rgb_nightmode = !rgb_nightmode;
     }
+    indicator_state_set(IND_NIGHTMODE, rgb_nightmode);
 }
 
 bool get_rgb_nightmode(void) {
@@ -37,7 +67,7 @@ bool get_rgb_nightmode(void) {
 
 // TIMEOUTS
 #ifdef IDLE_TIMEOUT_ENABLE
-static uint16_t timeout_timer = 0;
+static wheel_timer_t timeout_timer;
 static uint16_t timeout_counter = 0; //in minute intervals
 static uint16_t timeout_threshold = TIMEOUT_THRESHOLD_DEFAULT;
 
@@ -45,42 +75,132 @@ uint16_t get_timeout_threshold(void) {
     return timeout_threshold;
 }
 
+static void timeout_check(void) {
+    #ifdef RGB_MATRIX_ENABLE
+    if (timeout_threshold > 0 && timeout_counter >= timeout_threshold) {
+        rgb_matrix_disable_noeeprom();
+    }
+    #endif
+}
+
+// 1 minute tick on the timer wheel, stops once the timeout is reached until the next key press
+static void timeout_tick(wheel_timer_t *timer) {
+    timeout_counter++;
+    timeout_check();
+    if (timeout_counter < timeout_threshold) wheel_arm(timer, 60000, timeout_tick);
+}
+
 void timeout_reset_timer(void) {
-    timeout_timer = timer_read();
     timeout_counter = 0;
+    if (timeout_threshold > 0) wheel_arm(&timeout_timer, 60000, timeout_tick); // timeout_threshold = 0 will disable timeout
 };
 
 void timeout_update_threshold(bool increase) {
-    if (increase && timeout_threshold < TIMEOUT_THRESHOLD_MAX) timeout_threshold++;
-    if (!increase && timeout_threshold > 0) timeout_threshold--;
+    uint16_t threshold = timeout_threshold;
+    if (increase && threshold < TIMEOUT_THRESHOLD_MAX) threshold++;
+    if (!increase && threshold > 0) threshold--;
+    timeout_set_threshold(threshold);
 };
 
-void timeout_tick_timer(void) {
-    if (timeout_threshold > 0) {
-        if (timer_elapsed(timeout_timer) >= 60000) { // 1 minute tick
-            timeout_counter++;
-            timeout_timer = timer_read();
-        }
-        #ifdef RGB_MATRIX_ENABLE
-        if (timeout_threshold > 0 && timeout_counter >= timeout_threshold) {
-            rgb_matrix_disable_noeeprom();
-        }
-        #endif
-    } // timeout_threshold = 0 will disable timeout
-}
+void timeout_set_threshold(uint16_t threshold) {
+    timeout_threshold = threshold;
+    if (timeout_threshold == 0) {
+        wheel_cancel(&timeout_timer);
+    } else if (!wheel_is_armed(&timeout_timer) && timeout_counter < timeout_threshold) {
+        wheel_arm(&timeout_timer, 60000, timeout_tick);
+    }
+    timeout_check();
+    indicator_state_touch();
+};
 
 #endif // IDLE_TIMEOUT_ENABLE
 
-#if defined(IDLE_TIMEOUT_ENABLE) // timer features
 __attribute__((weak)) void matrix_scan_keymap(void) {}
 
 void matrix_scan_user(void) {
-    #ifdef IDLE_TIMEOUT_ENABLE
-    timeout_tick_timer();
+    wheel_task();
+    #ifdef RGB_BENCH_ENABLE
+    rgb_bench_scan();
+    #endif
+    #ifdef RGB_GOVERNOR_ENABLE
+    rgb_governor_scan();
+    #endif
+    #ifdef RGB_FRAME_DUMP_ENABLE
+    frame_dump_scan();
+    #endif
+    #ifndef MACRO_SPECULATE_DISABLE
+    macro_spec_scan();
     #endif
     matrix_scan_keymap();
 }
-#endif // IDLE_TIMEOUT_ENABLE
+
+// MACRO TIMING
+user_config_t user_config = { // defaults until user_config_load() runs from the deferred boot stage
+    .macro_delays   = MACRO_DELAY_DEFAULT * 0x041041, // the same delay in all four 6 bit fields
+    .macro_coalesce = MACRO_COALESCE_DEFAULT,
+    .macro_speculate = MACRO_SPECULATE_DEFAULT
+};
+
+static bool macro_tuning = false;
+static uint8_t tuned_macro = 0;
+
+uint8_t get_macro_delay(uint8_t macro) {
+    return (user_config.macro_delays >> (macro * 6)) & MACRO_DELAY_MAX;
+}
+
+static void set_macro_delay(uint8_t macro, uint8_t delay) {
+    user_config.macro_delays &= ~((uint32_t)MACRO_DELAY_MAX << (macro * 6));
+    user_config.macro_delays |= (uint32_t)delay << (macro * 6);
+}
+
+void macro_delay_update(uint8_t macro, bool increase) {
+    uint8_t delay = get_macro_delay(macro);
+    if (increase && delay < MACRO_DELAY_MAX) set_macro_delay(macro, delay + 1);
+    if (!increase && delay > 0) set_macro_delay(macro, delay - 1);
+    indicator_state_touch();
+}
+
+// Report coalescing merges steps due within this many ms, one poll of the host or a multiple of it
+uint8_t get_macro_poll_slot(void) {
+    return MACRO_POLL_INTERVAL << user_config.macro_poll_shift;
+}
+
+// Off, then slots of 1, 2, 4 and 8 poll intervals, then off again
+void macro_coalesce_step(void) {
+    if (!user_config.macro_coalesce) {
+        user_config.macro_coalesce = true;
+        user_config.macro_poll_shift = 0;
+    } else if (user_config.macro_poll_shift < MACRO_POLL_SHIFT_MAX) {
+        user_config.macro_poll_shift++;
+    } else {
+        user_config.macro_coalesce = false;
+    }
+    eeconfig_update_user(user_config.raw);
+}
+
+bool is_macro_tuning(void) {
+    return macro_tuning;
+}
+
+uint8_t get_tuned_macro(void) {
+    return tuned_macro;
+}
+
+void eeconfig_init_user(void) {
+    user_config.raw = 0;
+    for (uint8_t i = 0; i < MACRO_COUNT; i++) {
+        set_macro_delay(i, MACRO_DELAY_DEFAULT);
+    }
+    user_config.macro_coalesce = MACRO_COALESCE_DEFAULT;
+    user_config.macro_speculate = MACRO_SPECULATE_DEFAULT;
+    user_config.valid = true;
+    eeconfig_update_user(user_config.raw);
+}
+
+void user_config_load(void) {
+    user_config.raw = eeconfig_read_user();
+    if (!user_config.valid) eeconfig_init_user(); // EEPROM from before the user config existed
+}
 
 // Initialize variable holding the binary representation of active modifiers.
 uint8_t mod_state;
@@ -93,121 +213,335 @@ __attribute__((weak)) bool process_record_keymap(uint16_t keycode, keyrecord_t *
 
 static bool is_left_pressed, is_right_pressed, is_down_pressed;
 
+// Macro step sequences, played by the macro engine in arinl_macro.c
+static const macro_step_t macro_hpb_left[]     = { MUP(KC_A), MDOWN(KC_S), MDOWN(KC_A), MUP(KC_S), MUP(KC_A), MDOWN(KC_S), MDOWN(KC_A), MUP(KC_S) };
+static const macro_step_t macro_hpb_right[]    = { MUP(KC_D), MDOWN(KC_S), MDOWN(KC_D), MUP(KC_S), MUP(KC_D), MDOWN(KC_S), MDOWN(KC_D), MUP(KC_S) };
+static const macro_step_t macro_motion_left[]  = { MDOWN(KC_S), MUP(KC_A), MDOWN(KC_D), MUP(KC_S), MUP(KC_D), MDOWN(KC_A) };
+static const macro_step_t macro_motion_right[] = { MDOWN(KC_S), MUP(KC_D), MDOWN(KC_A), MUP(KC_S), MUP(KC_A), MDOWN(KC_D) };
+static const macro_step_t macro_tap_i[]        = { MDOWN(KC_I), MUP(KC_I) };
+static const macro_step_t macro_tap_j[]        = { MDOWN(KC_J), MUP(KC_J) };
+static const macro_step_t macro_tap_k[]        = { MDOWN(KC_K), MUP(KC_K) };
+static const macro_step_t macro_tap_l[]        = { MDOWN(KC_L), MUP(KC_L) };
+static const macro_step_t macro_hold_s[]       = { MDOWN(KC_S) };
+static const macro_step_t macro_buster_j[]     = { MDOWN_NOSHIFT(KC_J) };
+static const macro_step_t macro_buster_k[]     = { MDOWN(KC_K), MUP(KC_J), MUP(KC_K) };
+static const macro_step_t macro_flick[]        = { MDOWN(KC_J), MDOWN(KC_I), MUP(KC_J), MUP(KC_I) };
+
+// SPECULATIVE MACRO START
+// The macro keys' matrix positions are looked up on _FN4 once. Every scan compares their raw (undebounced) state
+// with the last one, and a fresh press edge on a key whose macro would play sends that macro's first step right
+// away. Contact bounce can lift the raw key for a scan or two after that edge, so the step is only rolled back
+// once the raw key has stayed up for a whole DEBOUNCE window without the debounced press arriving: debounce has
+// then thrown the edge away as chatter.
+#ifndef DEBOUNCE
+    #define DEBOUNCE 5 // QMK's default, only defined inside its debounce code
+#endif
+extern matrix_row_t raw_matrix[MATRIX_ROWS]; // QMK's undebounced matrix
+static keypos_t macro_spec_pos[MACRO_COUNT];
+static uint8_t macro_spec_found = 0;        // macros with a position on _FN4
+static uint8_t macro_spec_raw = 0;          // raw key state at the last scan
+static uint8_t macro_spec_key = MACRO_COUNT; // macro whose first step went out early
+static uint16_t macro_spec_up;              // when its raw key last went up
+static bool macro_spec_lifted = false;      // its raw key is up, for how long is in macro_spec_up
+static bool macro_spec_ready = false;
+
+// The sequence each macro key starts with, as picked in process_record_user
+static const macro_step_t *macro_first_step(uint8_t macro) {
+    if (!is_left_pressed && !is_right_pressed) return NULL; // plain key, no macro
+    if (macro == 0) return is_left_pressed ? macro_hpb_left : macro_hpb_right;
+    return is_left_pressed ? macro_motion_left : macro_motion_right;
+}
+
+static void macro_spec_find(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t pos = { .row = row, .col = col };
+            uint16_t keycode = keymap_key_to_keycode(_FN4, pos);
+            if (keycode < KC_MCRO1 || keycode > KC_MCRO4) continue;
+            macro_spec_pos[keycode - KC_MCRO1] = pos;
+            macro_spec_found |= 1 << (keycode - KC_MCRO1);
+        }
+    }
+    macro_spec_ready = true;
+}
+
+void macro_spec_scan(void) {
+    if (!macro_spec_ready) macro_spec_find();
+
+    if (macro_spec_key < MACRO_COUNT) {
+        keypos_t pos = macro_spec_pos[macro_spec_key];
+        if (!macro_is_speculating()) {
+            macro_spec_key = MACRO_COUNT; // the debounced press played it
+        } else if (raw_matrix[pos.row] & ((matrix_row_t)1 << pos.col)) {
+            macro_spec_lifted = false; // down again, a bounce
+        } else if (!macro_spec_lifted) {
+            macro_spec_lifted = true;
+            macro_spec_up = timer_read();
+        } else if (timer_elapsed(macro_spec_up) >= DEBOUNCE) {
+            macro_spec_cancel(); // rejected as chatter, take the step back
+            macro_spec_key = MACRO_COUNT;
+        }
+    }
+
+    for (uint8_t i = 0; i < MACRO_COUNT; i++) {
+        if (!(macro_spec_found & (1 << i))) continue;
+        keypos_t pos = macro_spec_pos[i];
+        bool raw = raw_matrix[pos.row] & ((matrix_row_t)1 << pos.col);
+        bool edge = raw && !(macro_spec_raw & (1 << i));
+        if (raw) {
+            macro_spec_raw |= 1 << i;
+        } else {
+            macro_spec_raw &= ~(1 << i);
+        }
+
+        if (!edge || matrix_is_on(pos.row, pos.col) || macro_is_playing() || macro_is_speculating() || macro_tuning) continue;
+        if (!(user_config.macro_speculate & (1 << i))) continue;
+        if (keymap_key_to_keycode(layer_switch_get_layer(pos), pos) != KC_MCRO1 + i) continue; // _FN4 not on top
+        const macro_step_t *steps = macro_first_step(i);
+        if (!steps) continue;
+        macro_speculate(steps);
+        macro_spec_key = i;
+        macro_spec_lifted = false;
+    }
+}
+
 bool process_record_user(uint16_t keycode, keyrecord_t * record) {
     mod_state = get_mods();
+    #ifdef USAGE_STATS_ENABLE
+    if (record -> event.pressed) usage_count_press(record -> event.key);
+    #endif
     if (!process_record_keymap(keycode, record)) {
         return false;
     }
 
+    #ifdef RGB_GOVERNOR_ENABLE
+    if (record->event.pressed) rgb_governor_keypress();
+    #endif
+    #ifdef RGB_MATRIX_CUSTOM_USER
+    if (record->event.pressed) rgb_matrix_reactive_bump(record->event.key.row, record->event.key.col);
+    #endif
+
+    if (keycode == KC_NUM && record->event.pressed) boot_numlock_keypress(); // the NumLock change that follows is the user's
+
+    // Direction keys are tracked before the gaming engines below can take over the event
+    switch (keycode) {
+    case KC_A:
+        is_left_pressed = record->event.pressed;
+        break;
+    case KC_D:
+        is_right_pressed = record->event.pressed;
+        break;
+    case KC_S:
+        is_down_pressed = record->event.pressed;
+        break;
+    }
+
+    #ifdef MACRO_RECORDER_ENABLE
+    if (!process_recorder(keycode, record)) {
+        return false;
+    }
+    #endif // MACRO_RECORDER_ENABLE
+    #ifdef TURBO_ENABLE
+    if (!process_turbo(keycode, record)) {
+        return false;
+    }
+    #endif // TURBO_ENABLE
+    #ifdef GAME_INPUT_ENABLE
+    if (!process_game_input(keycode, record)) {
+        return false;
+    }
+    #endif // GAME_INPUT_ENABLE
+
+    // In tuning mode the macro keys pick the macro the encoder tunes instead of firing it
+    if (macro_tuning && keycode >= KC_MCRO1 && keycode <= KC_MCRO4) {
+        if (record -> event.pressed) {
+            tuned_macro = keycode - KC_MCRO1;
+            indicator_state_touch();
+        }
+        macro_spec_cancel();
+        return false;
+    }
+
     // Key macros ...
     switch (keycode) {
         // WinKey lock
     case KC_WINLCK:
         if (record -> event.pressed) {
             keymap_config.no_gui = !keymap_config.no_gui; //toggle status
+            indicator_state_set(IND_WINLOCK, keymap_config.no_gui);
         } else unregister_code16(keycode);
         break;
 
-    case KC_A:
-        is_left_pressed = record->event.pressed;
-        break;
+    case KC_A: // tracked above
     case KC_D:
-        is_right_pressed = record->event.pressed;
-        break;
     case KC_S:
-        is_down_pressed = record->event.pressed;
         break;
 
     case KC_MCRO1: // hpb
          if (record -> event.pressed) {
             if (is_right_pressed || is_left_pressed) {
+                uint8_t delay = get_macro_delay(0);
                 if (is_left_pressed) {
-                    SEND_STRING_DELAY(SS_UP(X_A) SS_DOWN(X_S) SS_DOWN(X_A) SS_UP(X_S) SS_UP(X_A) SS_DOWN(X_S) SS_DOWN(X_A) SS_UP(X_S), 18);
+                    MACRO_PLAY(macro_hpb_left, delay);
                 }
                 if (is_right_pressed) {
-                    SEND_STRING_DELAY(SS_UP(X_D) SS_DOWN(X_S) SS_DOWN(X_D) SS_UP(X_S) SS_UP(X_D) SS_DOWN(X_S) SS_DOWN(X_D) SS_UP(X_S), 18);
+                    MACRO_PLAY(macro_hpb_right, delay);
                 }
                 if (!(mod_state & MOD_MASK_SHIFT)) {
-                    SEND_STRING_DELAY(SS_DOWN(X_J) SS_UP(X_J), 18);
+                    MACRO_PLAY(macro_tap_j, delay);
                 }
-                SEND_STRING_DELAY(SS_DOWN(X_I) SS_UP(X_I), 18);
+                MACRO_PLAY(macro_tap_i, delay);
                 if ((mod_state & MOD_MASK_SHIFT)) {
-                    SEND_STRING_DELAY(SS_DOWN(X_K) SS_UP(X_K), 18);
+                    MACRO_PLAY(macro_tap_k, delay);
                 }
+                macro_finish();
             } else {
-                register_code(KC_COMM);
+                macro_spec_cancel(); // the direction was let go in the meantime
+                key_owner_tap(KC_COMM, KO_PHYSICAL, true);
             }
-         } else unregister_code(KC_COMM);
+         } else key_owner_tap(KC_COMM, KO_PHYSICAL, false);
          break;
 
     case KC_MCRO2: // giganter
          if (record -> event.pressed) {
             if (is_right_pressed || is_left_pressed) {
+                uint8_t delay = get_macro_delay(1);
                 if (is_left_pressed) {
-                    SEND_STRING_DELAY(SS_DOWN(X_S) SS_UP(X_A) SS_DOWN(X_D) SS_UP(X_S) SS_UP(X_D) SS_DOWN(X_A), 18);
+                    MACRO_PLAY(macro_motion_left, delay);
                 }
                 if (is_right_pressed) { 
-                    SEND_STRING_DELAY(SS_DOWN(X_S) SS_UP(X_D) SS_DOWN(X_A) SS_UP(X_S) SS_UP(X_A) SS_DOWN(X_D), 18);
+                    MACRO_PLAY(macro_motion_right, delay);
                 }
                 if (!(mod_state & MOD_MASK_SHIFT)) {
-                    SEND_STRING_DELAY(SS_DOWN(X_J) SS_UP(X_J), 18);
+                    MACRO_PLAY(macro_tap_j, delay);
                 }
-                SEND_STRING_DELAY(SS_DOWN(X_L) SS_UP(X_L), 18);
+                MACRO_PLAY(macro_tap_l, delay);
                 if ((mod_state & MOD_MASK_SHIFT)) {
-                    SEND_STRING_DELAY(SS_DOWN(X_K) SS_UP(X_K), 18);
+                    MACRO_PLAY(macro_tap_k, delay);
                 }
                 if (is_down_pressed) {
-                    SEND_STRING_DELAY(SS_DOWN(X_S), 18);
+                    MACRO_PLAY(macro_hold_s, delay);
                 }
+                macro_finish();
             } else {
-                register_code(KC_N);
+                macro_spec_cancel(); // the direction was let go in the meantime
+                key_owner_tap(KC_N, KO_PHYSICAL, true);
             }
-         } else unregister_code(KC_N);
+         } else key_owner_tap(KC_N, KO_PHYSICAL, false);
          break;
     
     case KC_MCRO3: // buster
         if (record -> event.pressed) {
             if (is_right_pressed || is_left_pressed) {
+                uint8_t delay = get_macro_delay(2);
                 if (is_left_pressed) {
-                    SEND_STRING_DELAY(SS_DOWN(X_S) SS_UP(X_A) SS_DOWN(X_D) SS_UP(X_S) SS_UP(X_D) SS_DOWN(X_A), 18);
+                    MACRO_PLAY(macro_motion_left, delay);
                 }
                 if (is_right_pressed) { 
-                    SEND_STRING_DELAY(SS_DOWN(X_S) SS_UP(X_D) SS_DOWN(X_A) SS_UP(X_S) SS_UP(X_A) SS_DOWN(X_D), 18);
+                    MACRO_PLAY(macro_motion_right, delay);
                 }
                 if (!(mod_state & MOD_MASK_SHIFT)) { //shift is not pressed
-                    del_mods(MOD_MASK_SHIFT);
-                    SEND_STRING_DELAY(SS_DOWN(X_J), 18);
-                    set_mods(mod_state);
+                    MACRO_PLAY(macro_buster_j, delay); // J goes out with shift masked in the same report
                 }
-                SEND_STRING_DELAY(SS_DOWN(X_K) SS_UP(X_J) SS_UP(X_K), 18);
+                MACRO_PLAY(macro_buster_k, delay);
                 if (is_down_pressed) {
-                    SEND_STRING_DELAY(SS_DOWN(X_S), 18);
+                    MACRO_PLAY(macro_hold_s, delay);
                 }
+                macro_finish();
             } else {
-                register_code(KC_M);
+                macro_spec_cancel(); // the direction was let go in the meantime
+                key_owner_tap(KC_M, KO_PHYSICAL, true);
             }
-         } else unregister_code(KC_M);
+         } else key_owner_tap(KC_M, KO_PHYSICAL, false);
          break;
 
     case KC_MCRO4: // flick
         if (record -> event.pressed) {
             // if ((mod_state & MOD_MASK_SHIFT) && (is_right_pressed || is_left_pressed)) {
             if (is_right_pressed || is_left_pressed) {
+                uint8_t delay = get_macro_delay(3);
                 if (is_left_pressed) {
-                    SEND_STRING_DELAY(SS_DOWN(X_S) SS_UP(X_A) SS_DOWN(X_D) SS_UP(X_S) SS_UP(X_D) SS_DOWN(X_A), 18);
+                    MACRO_PLAY(macro_motion_left, delay);
                 }
                 if (is_right_pressed) { 
-                    SEND_STRING_DELAY(SS_DOWN(X_S) SS_UP(X_D) SS_DOWN(X_A) SS_UP(X_S) SS_UP(X_A) SS_DOWN(X_D), 18);
+                    MACRO_PLAY(macro_motion_right, delay);
                 }
                 if (is_right_pressed || is_left_pressed) {
-                    SEND_STRING_DELAY(SS_DOWN(X_J) SS_DOWN(X_I) SS_UP(X_J) SS_UP(X_I), 18);
+                    MACRO_PLAY(macro_flick, delay);
                 }
+                macro_finish();
             } else {
-                register_code(KC_U);
+                macro_spec_cancel(); // the direction was let go in the meantime
+                key_owner_tap(KC_U, KO_PHYSICAL, true);
             }
-         } else unregister_code(KC_U);
+         } else key_owner_tap(KC_U, KO_PHYSICAL, false);
          break;
 
+    #ifdef RGB_BENCH_ENABLE
+    case RGB_BNCH:
+        if (record -> event.pressed) {
+            rgb_bench_start();
+        }
+        break;
+    #endif // RGB_BENCH_ENABLE
+
+    #ifdef RGB_FRAME_DUMP_ENABLE
+    case RGB_DUMP:
+        if (record -> event.pressed) {
+            frame_dump_start();
+        }
+        break;
+    #endif // RGB_FRAME_DUMP_ENABLE
+
+    #ifdef USAGE_STATS_ENABLE
+    case KC_USAGE:
+        if (record -> event.pressed) {
+            if (mod_state & MOD_MASK_SHIFT) {
+                usage_clear();
+            } else {
+                usage_print();
+            }
+        }
+        break;
+    #endif // USAGE_STATS_ENABLE
+
+    #ifdef EEPROM_BENCH_ENABLE
+    case KC_EEBN:
+        if (record -> event.pressed) {
+            eebench_start();
+        }
+        break;
+    #endif // EEPROM_BENCH_ENABLE
+
+    #ifdef SOAK_TEST_ENABLE
+    case KC_SOAK:
+        if (record -> event.pressed) {
+            soak_start(mod_state & MOD_MASK_SHIFT);
+        }
+        break;
+    #endif // SOAK_TEST_ENABLE
+
+    case MC_CLSC:
+        if (record -> event.pressed) {
+            macro_coalesce_step();
+        }
+        break;
+
+    case MC_SPEC:
+        if (record -> event.pressed) {
+            user_config.macro_speculate ^= 1 << tuned_macro;
+            eeconfig_update_user(user_config.raw);
+        }
+        break;
+
+    case MC_TUNE:
+        if (record -> event.pressed) {
+            macro_tuning = !macro_tuning;
+            indicator_state_set(IND_TUNING, macro_tuning);
+            if (!macro_tuning) eeconfig_update_user(user_config.raw); // persist once when leaving, not on every detent
+        }
+        break;
+
     #ifdef IDLE_TIMEOUT_ENABLE
     case RGB_TOI:
         if (record -> event.pressed) {
@@ -223,7 +557,7 @@ bool process_record_user(uint16_t keycode, keyrecord_t * record) {
         #ifdef RGB_MATRIX_ENABLE
     case RGB_NITE:
         if (record -> event.pressed) {
-            rgb_nightmode = !rgb_nightmode;
+            activate_rgb_nightmode(!rgb_nightmode);
         } else unregister_code16(keycode);
         break;
         #endif // RGB_MATRIX_ENABLE
@@ -239,12 +573,20 @@ bool process_record_user(uint16_t keycode, keyrecord_t * record) {
         }
         break;
     }
+    if (IS_BASIC_KEYCODE(keycode) || IS_MODIFIER_KEYCODE(keycode)) return key_owner_record(keycode, record); // physical keys share the ownership table with the macros
     return true;
 };
 
-// Sets numlock on in numpad _FN2 layer
+// Tracks the highest layer for the indicators and sets numlock on in numpad _FN2 layer
 layer_state_t layer_state_set_user(layer_state_t state) {
   static bool adjust_on = false;
+  indicator_state = (indicator_state & ~IND_LAYER_MASK) | ((uint32_t)get_highest_layer(state) << IND_LAYER_SHIFT);
+  #ifdef USAGE_STATS_ENABLE
+  usage_layer_change(get_highest_layer(state));
+  #endif
+  #ifdef RGB_GOVERNOR_ENABLE
+  rgb_governor_layer_change(state);
+  #endif
   if (adjust_on != IS_LAYER_ON_STATE(state, _FN2)) {
     adjust_on = !adjust_on;
     if (adjust_on) {  // Just entered the _FN2 layer.
@@ -256,22 +598,15 @@ layer_state_t layer_state_set_user(layer_state_t state) {
   return state;
 }
 
-// Turn on/off NUM LOCK if current state is different
-void activate_numlock(bool turn_on) {
-    if (host_keyboard_led_state().num_lock != turn_on) {
-        tap_code(KC_NUM);
-    }
-}
-
 // INITIAL STARTUP
 __attribute__((weak)) void keyboard_post_init_keymap(void) {}
 
 void keyboard_post_init_user(void) {
+    boot_start(); // config, RGB and NumLock come up from the scan loop, see arinl_boot.c
+    cycle_counter_init();
+    indicator_state_set(IND_WINLOCK, keymap_config.no_gui);
     keyboard_post_init_keymap();
-    #ifdef STARTUP_NUMLOCK_ON
-    activate_numlock(true); // turn on Num lock by default so that the numpad layer always has predictable results
-    #endif // STARTUP_NUMLOC_ON
     #ifdef IDLE_TIMEOUT_ENABLE
-    timeout_timer = timer_read(); // set initial time for idle timeout
+    timeout_reset_timer(); // start the idle timeout
     #endif
 }
\ No newline at end of file
@@ -40,6 +40,26 @@ enum custom_user_keycodes {
         KC_MCRO2,
         KC_MCRO3,
         KC_MCRO4,
+        MC_TUNE,       // Toggles macro timing tuning with the encoder
+        MC_CLSC,       // Steps macro report coalescing through off and 1, 2, 4 and 8 poll intervals
+        MC_SPEC,       // Toggles the speculative start of the tuned macro
+
+        TB_SET,        // Hold and tap a key to mark/unmark it as a turbo key
+        TB_RATU,       // Turbo rate up
+        TB_RATD,       // Turbo rate down
+
+        MR_REC,        // Start/stop recording a timed macro
+        MR_PLAY,       // Play/stop the recorded macro
+        MR_QNTZ,       // Snap the recorded macro to game frames
+        MR_SAVE,       // Save the recorded macro to EEPROM
+        MR_FAST,       // Replay the recorded macro faster
+        MR_SLOW,       // Replay the recorded macro slower
+
+        RGB_BNCH,      // Benchmark every RGB effect, results on the console
+        RGB_DUMP,      // Print the next few indicator frames to the console
+        KC_SOAK,       // Randomized key pipeline soak test, results on the console, the volume run with shift
+        KC_USAGE,      // Print the key and layer usage counters, clear them with shift
+        KC_EEBN,       // Benchmark EEPROM write stalls, results on the console
 
         NEW_SAFE_RANGE // New safe range for keymap level custom keycodes
 };
@@ -52,6 +72,7 @@ void encoder_action_navword(bool clockwise);
 void encoder_action_navpage(bool clockwise);
 
 uint8_t get_selected_layer(void);
+void set_selected_layer(uint8_t layer);
 void encoder_action_layerchange(bool clockwise);
 
 #if defined(RGB_MATRIX_ENABLE) || defined(RGBLIGHT_ENABLE)
@@ -68,6 +89,27 @@ void activate_rgb_nightmode(bool turn_on);
 bool get_rgb_nightmode(void);
 #endif
 
+// INDICATOR STATE
+// Everything the RGB indicators depend on, kept up to date by the events that change it so the keymap only has
+// to work out its indicator overlay again when this word changes
+enum indicator_state_bits {
+    IND_NUM_LOCK    = 1 << 0,
+    IND_CAPS_LOCK   = 1 << 1,
+    IND_SCROLL_LOCK = 1 << 2,
+    IND_WINLOCK     = 1 << 3,
+    IND_NIGHTMODE   = 1 << 4,
+    IND_RECORDING   = 1 << 5,
+    IND_PLAYING     = 1 << 6,
+    IND_TUNING      = 1 << 7
+};
+#define IND_LAYER_SHIFT 8             // highest active layer in bits 8-15
+#define IND_LAYER_MASK (0xFFUL << IND_LAYER_SHIFT)
+#define IND_SERIAL_ONE (1UL << 24)    // bits 24-31 count changes to the values the readouts show
+//prototype  functions
+uint32_t get_indicator_state(void);
+void indicator_state_set(uint32_t bits, bool on);
+void indicator_state_touch(void);
+
 // IDLE TIMEOUTS
 #ifdef IDLE_TIMEOUT_ENABLE
 #define TIMEOUT_THRESHOLD_DEFAULT 4 // default timeout minutes
@@ -76,8 +118,260 @@ bool get_rgb_nightmode(void);
 uint16_t get_timeout_threshold(void);
 void timeout_reset_timer(void);
 void timeout_update_threshold(bool increase);
-void timeout_tick_timer(void);
+void timeout_set_threshold(uint16_t threshold);
 #endif //IDLE_TIMEOUT_ENABLE
 
+// TIMER WHEEL
+typedef struct wheel_timer_t wheel_timer_t;
+typedef void (*wheel_callback_t)(wheel_timer_t *timer);
+struct wheel_timer_t {
+    wheel_timer_t   *next;
+    wheel_timer_t  **pprev;   // NULL while the timer is not armed
+    wheel_callback_t callback;
+    uint16_t         rounds;  // full turns of the wheel left before it fires
+};
+//prototype  functions
+void wheel_arm(wheel_timer_t *timer, uint16_t delay_ms, wheel_callback_t callback);
+void wheel_cancel(wheel_timer_t *timer);
+bool wheel_is_armed(const wheel_timer_t *timer);
+void wheel_task(void);
+
+// CYCLE COUNTER
+//prototype  functions
+void cycle_counter_init(void);
+uint32_t cycle_read(void);
+uint32_t cycles_to_us(uint32_t cycles);
+
+// TURBO
+#ifdef TURBO_ENABLE
+#ifndef TURBO_MAX_KEYS
+#define TURBO_MAX_KEYS 4 // keys that can be marked as turbo at the same time
+#endif
+#ifndef TURBO_RATE_DEFAULT
+#define TURBO_RATE_DEFAULT 15 // default taps per second
+#endif
+#define TURBO_RATE_MIN 2
+#define TURBO_RATE_MAX 30
+//prototype  functions
+uint8_t get_turbo_rate(void);
+void turbo_update_rate(bool increase);
+bool process_turbo(uint16_t keycode, keyrecord_t *record);
+#endif // TURBO_ENABLE
+
+// GAME TIMING
+#ifndef GAME_FRAME_RATE
+#define GAME_FRAME_RATE 60 // frames per second that press patterns and recordings are timed against
+#endif
+
+// GAME INPUTS
+#ifdef GAME_INPUT_ENABLE
+#ifndef GAME_INPUT_MAX
+#define GAME_INPUT_MAX 8 // entries of game_inputs[] that are used
+#endif
+enum game_input_modes {
+    GI_PLINK, // re-press the key after `frames` frames
+    GI_HOLD   // hold the key for at least `frames` frames
+};
+typedef struct {
+    uint8_t layer;   // only applies while this is the highest active layer
+    uint8_t keycode;
+    uint8_t mode;
+    uint8_t frames;
+} game_input_t;
+extern const game_input_t game_inputs[]; // defined in keymap.c
+extern const uint8_t game_inputs_count;
+//prototype  functions
+uint16_t game_frames_to_ms(uint8_t frames);
+bool process_game_input(uint16_t keycode, keyrecord_t *record);
+#endif // GAME_INPUT_ENABLE
+
+// MACRO RECORDER
+#ifdef MACRO_RECORDER_ENABLE
+#ifndef MACRO_RECORDER_SIZE
+#define MACRO_RECORDER_SIZE 64 // recorded key edges, 4 bytes each in RAM and EEPROM
+#endif
+#ifndef MACRO_RECORDER_SCALE
+#define MACRO_RECORDER_SCALE 100 // replay speed in percent of the recorded timing
+#endif
+#define MACRO_RECORDER_SCALE_STEP 10
+#define MACRO_RECORDER_SCALE_MIN 10
+#define MACRO_RECORDER_SCALE_MAX 250
+//prototype  functions
+void recorder_init(void);
+bool recorder_is_recording(void);
+bool recorder_is_playing(void);
+uint8_t get_recorder_scale(void);
+void recorder_update_scale(bool slower);
+bool process_recorder(uint16_t keycode, keyrecord_t *record);
+#endif // MACRO_RECORDER_ENABLE
+
+// USER CONFIG (persisted with eeconfig_update_user)
+typedef union {
+    uint32_t raw;
+    struct {
+        uint32_t macro_delays : 24; // 4 x 6 bit inter-step delay in ms, one per KC_MCRO key
+        bool     valid        : 1;  // cleared on EEPROM written by older firmware
+        bool     macro_coalesce : 1; // merge compatible macro edges into one report
+        uint32_t macro_speculate : 4; // one bit per KC_MCRO key, send the first step on the raw press edge
+        uint32_t macro_poll_shift : 2; // coalescing slot is MACRO_POLL_INTERVAL << macro_poll_shift ms
+    };
+} user_config_t;
+extern user_config_t user_config;
+//prototype  functions
+void user_config_load(void);
+
+// MACRO TIMING
+#define MACRO_COUNT 4
+#ifndef MACRO_DELAY_DEFAULT
+#define MACRO_DELAY_DEFAULT 18 // default inter-step delay (ms)
+#endif
+#define MACRO_DELAY_MAX 63 // fits the 6 bits each macro has in user_config
+#ifndef MACRO_COALESCE_DEFAULT
+#define MACRO_COALESCE_DEFAULT false
+#endif
+#ifdef MACRO_SPECULATE_DISABLE
+#undef MACRO_SPECULATE_DEFAULT
+#define MACRO_SPECULATE_DEFAULT 0x00 // no raw edge scan at all, MC_SPEC does nothing
+#elif !defined(MACRO_SPECULATE_DEFAULT)
+#define MACRO_SPECULATE_DEFAULT 0x0F // all four macros start on the raw edge
+#endif
+#ifndef MACRO_POLL_INTERVAL
+#ifdef USB_POLLING_INTERVAL_MS
+#define MACRO_POLL_INTERVAL USB_POLLING_INTERVAL_MS // the bInterval the keyboard asks the host for
+#else
+#define MACRO_POLL_INTERVAL 1 // QMK's default bInterval
+#endif
+#endif
+#define MACRO_POLL_SHIFT_MAX 3 // coalescing slots up to 8 poll intervals, for hosts or games that read slower
+//prototype  functions
+uint8_t get_macro_delay(uint8_t macro);
+void macro_delay_update(uint8_t macro, bool increase);
+uint8_t get_macro_poll_slot(void);
+void macro_coalesce_step(void);
+bool is_macro_tuning(void);
+uint8_t get_tuned_macro(void);
+
+// MACRO ENGINE
+enum macro_step_flags {
+    MS_DOWN    = 0x01, // press the key, otherwise release it
+    MS_NOSHIFT = 0x02  // the report carrying this step goes out with shift masked off
+};
+typedef struct {
+    uint8_t keycode;
+    uint8_t flags;
+} macro_step_t;
+#define MDOWN(kc) { (kc), MS_DOWN }
+#define MUP(kc) { (kc), 0 }
+#define MDOWN_NOSHIFT(kc) { (kc), MS_DOWN | MS_NOSHIFT }
+#define MACRO_PLAY(steps, delay) macro_play((steps), ARRAY_SIZE(steps), (delay))
+//prototype  functions
+void macro_play(const macro_step_t *steps, uint8_t count, uint8_t delay);
+void macro_finish(void);
+bool macro_is_playing(void);
+void macro_speculate(const macro_step_t *step);
+bool macro_is_speculating(void);
+void macro_spec_cancel(void);
+void macro_spec_scan(void);
+
+// KEY OWNERSHIP
+enum key_owners {
+    KO_PHYSICAL      = 0x01, // counted, several switches can hold the same keycode
+    KO_PHYSICAL_MASK = 0x07,
+    KO_MACRO         = 0x08,
+    KO_TURBO         = 0x10,
+    KO_GAME          = 0x20,
+    KO_RECORDER      = 0x40,
+    KO_SUPPRESS      = 0x80  // a macro released the key while someone else still holds it
+};
+//prototype  functions
+void key_owner_set(uint8_t keycode, uint8_t owner, bool down);
+void key_owner_tap(uint8_t keycode, uint8_t owner, bool down);
+bool key_owner_flush(void);
+void key_owner_release_all(uint8_t owner);
+bool key_owner_is_down(uint8_t keycode);
+bool key_owner_is_idle(void);
+void key_owner_clear(void);
+bool key_owner_record(uint16_t keycode, keyrecord_t *record);
+
+// RGB EFFECT BENCHMARK
+#ifdef RGB_BENCH_ENABLE
+//prototype  functions
+void rgb_bench_start(void);
+void rgb_bench_scan(void);
+bool rgb_bench_frame(uint8_t led_min, uint8_t led_max);
+bool is_rgb_bench_running(void);
+#endif // RGB_BENCH_ENABLE
+
+// USER DATABLOCK LAYOUT
+#define RECORDER_DATABLOCK_OFFSET 0
+#define USAGE_DATABLOCK_OFFSET 260 // after the macro recorder's 4 byte header and 64 edges
+#define EEBENCH_DATABLOCK_OFFSET 460 // after the usage stats, the EEPROM benchmark's scratch region
+#define EEBENCH_DATABLOCK_SIZE 260   // the largest write it replays, a full macro recording
+
+// USAGE STATS
+#ifdef USAGE_STATS_ENABLE
+//prototype  functions
+void usage_init(void);
+void usage_count_press(keypos_t key);
+void usage_layer_change(uint8_t layer);
+void usage_print(void);
+void usage_clear(void);
+#endif // USAGE_STATS_ENABLE
+
+// EEPROM WRITE BENCHMARK
+#ifdef EEPROM_BENCH_ENABLE
+//prototype  functions
+void eebench_start(void);
+#endif // EEPROM_BENCH_ENABLE
+
+// PIPELINE SOAK TEST
+#ifdef SOAK_TEST_ENABLE
+//prototype  functions
+void soak_start(bool fast);
+bool soak_is_running(void);
+#endif // SOAK_TEST_ENABLE
+
+// RGB FRAME DUMP
+#ifdef RGB_FRAME_DUMP_ENABLE
+//prototype  functions
+void frame_dump_start(void);
+void frame_dump_scan(void);
+void frame_dump_begin(uint8_t led_min, uint8_t led_max);
+void frame_dump_end(uint8_t led_min, uint8_t led_max);
+#endif // RGB_FRAME_DUMP_ENABLE
+
+// RGB POWER LIMIT
+#ifdef RGB_POWER_LIMIT_ENABLE
+//prototype  functions
+uint8_t rgb_power_scale8(uint8_t value);
+uint16_t get_rgb_power_ma(void);
+void rgb_power_frame_end(uint32_t overlay_sum, uint8_t overlay_leds, bool effect_visible);
+#endif // RGB_POWER_LIMIT_ENABLE
+
+// RGB GOVERNOR
+#ifdef RGB_GOVERNOR_ENABLE
+//prototype  functions
+void rgb_governor_keypress(void);
+void rgb_governor_scan(void);
+void rgb_governor_layer_change(layer_state_t state);
+bool is_rgb_throttled(void);
+uint32_t get_scan_period_us(void);
+#endif // RGB_GOVERNOR_ENABLE
+
+// USERSPACE RGB EFFECTS
+#ifdef RGB_MATRIX_CUSTOM_USER
+//prototype  functions
+void rgb_matrix_reactive_bump(uint8_t row, uint8_t col);
+#endif // RGB_MATRIX_CUSTOM_USER
+
+// BOOT STAGES
+//prototype  functions
+void boot_start(void);
+void boot_numlock_keypress(void);
+void boot_led_update(led_t led_state);
+
 // OTHER FUNCTION PROTOTYPE
-void activate_numlock(bool turn_on);
\ No newline at end of file
+void activate_numlock(bool turn_on);
+void numlock_led_update(led_t led_state);
+bool get_numlock_target(void);
+bool numlock_is_busy(void);
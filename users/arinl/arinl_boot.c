@@ -0,0 +1,145 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// BOOT STAGES
+// keyboard_post_init_user only does what the first key press needs and returns, so matrix scanning starts right
+// away. Everything else runs from the timer wheel once the scan loop is going:
+//   BOOT_CONFIG   first scans: user config, the saved macro recording and usage counters are read from EEPROM
+//   BOOT_RGB      RGB rendering, held off until BOOT_RGB_DELAY_MS so it doesn't compete with the first scans
+//   BOOT_NUMLOCK  NumLock sync, once the host has had BOOT_NUMLOCK_DELAY_MS to enumerate and send its LED state
+// The NumLock stage runs again on USB wakeup (a KVM switch suspends the port and wakes it on the other machine)
+// and on the first LED change the host reports after boot or wakeup, in case it enumerated after the stage ran.
+// Other NumLock changes are the user's, from this keyboard or another one, and are left alone, except while _FN2
+// is on: the numpad layer needs NumLock, so a change there not caused by this keyboard's NumLock key is undone.
+// Stage times (ms since the keyboard timer started) go to the console when the last stage is done, and again
+// after each NumLock re-sync.
+#ifndef BOOT_RGB_DELAY_MS
+    #define BOOT_RGB_DELAY_MS 200
+#endif
+#ifndef BOOT_NUMLOCK_DELAY_MS
+    #define BOOT_NUMLOCK_DELAY_MS 500
+#endif
+#ifndef BOOT_NUMLOCK_KEY_MS
+    #define BOOT_NUMLOCK_KEY_MS 1000 // LED reports this soon after a KC_NUM press are the user's doing
+#endif
+
+enum boot_stages {
+    BOOT_CONFIG,
+    BOOT_RGB,
+    BOOT_NUMLOCK,
+    BOOT_DONE
+};
+
+static uint8_t boot_stage = BOOT_DONE;
+static uint32_t boot_times[BOOT_DONE];
+static uint32_t boot_post_init;
+static bool boot_rgb_held = false;    // RGB was on and is waiting for BOOT_RGB
+static uint32_t boot_numlock_key;     // last KC_NUM press
+static bool boot_led_seen = false;    // an LED change came in since boot or wakeup
+static wheel_timer_t boot_timer;
+
+static void boot_numlock_sync(void) {
+    #ifdef STARTUP_NUMLOCK_ON
+    activate_numlock(true); // turn on Num lock by default so that the numpad layer always has predictable results
+    #else
+    if (IS_LAYER_ON(_FN2)) activate_numlock(true);
+    #endif // STARTUP_NUMLOCK_ON
+}
+
+static void boot_step(wheel_timer_t *timer) {
+    switch (boot_stage) {
+    case BOOT_CONFIG:
+        user_config_load();
+        #ifdef MACRO_RECORDER_ENABLE
+        recorder_init(); // load the saved recording
+        #endif
+        #ifdef USAGE_STATS_ENABLE
+        usage_init();
+        #endif
+        break;
+    case BOOT_RGB:
+        #ifdef RGB_MATRIX_ENABLE
+        if (boot_rgb_held && !rgb_matrix_is_enabled()) rgb_matrix_enable_noeeprom();
+        boot_rgb_held = false;
+        #endif
+        break;
+    case BOOT_NUMLOCK:
+        boot_numlock_sync();
+        break;
+    }
+    boot_times[boot_stage++] = timer_read32();
+
+    switch (boot_stage) {
+    case BOOT_RGB:
+        wheel_arm(&boot_timer, BOOT_RGB_DELAY_MS, boot_step);
+        break;
+    case BOOT_NUMLOCK:
+        wheel_arm(&boot_timer, BOOT_NUMLOCK_DELAY_MS - BOOT_RGB_DELAY_MS, boot_step);
+        break;
+    case BOOT_DONE:
+        uprintf("boot: post_init %lu ms, config %lu ms, rgb %lu ms, numlock %lu ms\n", boot_post_init, boot_times[BOOT_CONFIG], boot_times[BOOT_RGB], boot_times[BOOT_NUMLOCK]);
+        break;
+    }
+}
+
+// Called first thing from keyboard_post_init_user
+void boot_start(void) {
+    boot_post_init = timer_read32();
+    #ifdef RGB_MATRIX_ENABLE
+    if (rgb_matrix_is_enabled()) {
+        boot_rgb_held = true;
+        rgb_matrix_disable_noeeprom();
+    }
+    #endif
+    boot_stage = BOOT_CONFIG;
+    wheel_arm(&boot_timer, 1, boot_step); // fires from the first scans
+}
+
+static void boot_numlock_restart(void) {
+    if (boot_stage != BOOT_DONE) return; // still booting, the NumLock stage is coming anyway
+    boot_stage = BOOT_NUMLOCK;
+    wheel_arm(&boot_timer, BOOT_NUMLOCK_DELAY_MS, boot_step);
+}
+
+void suspend_wakeup_init_user(void) {
+    key_owner_clear(); // QMK cleared the report before calling us
+    boot_led_seen = false;
+    boot_numlock_restart();
+}
+
+// Called from process_record_user on KC_NUM presses
+void boot_numlock_keypress(void) {
+    boot_numlock_key = timer_read32();
+}
+
+// Called from led_update_user before numlock_led_update; QMK only calls it when the host's LEDs change
+void boot_led_update(led_t led_state) {
+    static bool num_lock = false;
+    bool changed = led_state.num_lock != num_lock;
+    bool first = !boot_led_seen; // the host's first word since boot or wakeup, it may have enumerated only now
+    num_lock = led_state.num_lock;
+    boot_led_seen = true;
+    if (!changed || numlock_is_busy()) return; // no NumLock change, or the answer to our own toggle
+    #ifdef SOAK_TEST_ENABLE
+    if (soak_is_running()) return; // the soak's stand-in host toggling, not a new host
+    #endif
+    if (!first && (!IS_LAYER_ON(_FN2) || timer_elapsed32(boot_numlock_key) < BOOT_NUMLOCK_KEY_MS)) return;
+    boot_numlock_restart();
+}
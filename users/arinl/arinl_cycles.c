@@ -0,0 +1,41 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+#include <hal.h>
+
+#include "arinl.h"
+
+// CYCLE COUNTER
+// QMK's timer counts whole milliseconds, too coarse for a frame render or a single EEPROM write. The Cortex-M4
+// DWT cycle counter runs at the core clock, so differences of cycle_read() are exact to a few cycles; it wraps
+// about once a minute at 72 MHz, fine for timing anything shorter than that.
+#ifndef CYCLE_COUNTER_HZ
+    #define CYCLE_COUNTER_HZ STM32_HCLK
+#endif
+
+void cycle_counter_init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t cycle_read(void) {
+    return DWT->CYCCNT;
+}
+
+uint32_t cycles_to_us(uint32_t cycles) {
+    return cycles / (CYCLE_COUNTER_HZ / 1000000);
+}
@@ -0,0 +1,152 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// EEPROM WRITE BENCHMARK
+// KC_EEBN replays the writes this userspace makes against the real flash-emulated EEPROM and prints how long
+// each kind stalls the scan loop. Patterns:
+//   rgb        a hue step saved with eeconfig_update_rgb_matrix (RGB_MOD/RGB_HUI and friends)
+//   user       the user config word (MC_TUNE, MC_CLSC, MC_SPEC)
+//   recording  a macro recorder save (MR_SAVE) that changes one recorded edge
+//   usage      a usage counter checkpoint that changes one layer's time
+// Every pattern writes its real size into the benchmark's own scratch region at the end of the user datablock,
+// which nothing else reads, with as many bytes changed as the real write changes, so the wear-leveling log grows
+// like it does in use. Each write inverts those bytes of what the scratch region holds now, so the driver can't
+// skip it as a no-op. The settings in RAM, the stored configs, the recording and the usage counters are never
+// touched, a reset halfway leaves only the scratch region changed. One write goes out every EEBENCH_INTERVAL_MS
+// from the timer wheel, so typing keeps working in between. Stalls are timed with the cycle counter; one of
+// EEBENCH_COMPACT_US or more is counted as a compaction (the write log filled and the backing store was erased
+// and rewritten).
+// Each run costs EEBENCH_ROUNDS x 8 writes of flash wear, keep it for when sizes or write policies change.
+#ifndef EEBENCH_ROUNDS
+    #define EEBENCH_ROUNDS 16
+#endif
+#ifndef EEBENCH_INTERVAL_MS
+    #define EEBENCH_INTERVAL_MS 20
+#endif
+#ifndef EEBENCH_COMPACT_US
+    #define EEBENCH_COMPACT_US 5000
+#endif
+
+enum eebench_patterns {
+    EB_RGB,
+    EB_USER,
+    EB_RECORDING,
+    EB_USAGE,
+    EB_PATTERNS
+};
+
+static const char *const eebench_names[EB_PATTERNS] = { "rgb", "user", "recording", "usage" };
+
+typedef struct {
+    uint16_t writes;
+    uint32_t total_us;
+    uint32_t max_us;
+} eebench_stat_t;
+
+typedef struct {
+    uint16_t length; // of the real write
+    uint8_t delta;   // offset of the changed bytes in it
+    uint8_t changed; // bytes the real write changes
+} eebench_write_t;
+
+#ifdef RGB_MATRIX_ENABLE
+    #define EEBENCH_RGB_SIZE sizeof(rgb_config_t)
+#else
+    #define EEBENCH_RGB_SIZE 0
+#endif
+
+static const eebench_write_t eebench_writes[EB_PATTERNS] = {
+    [EB_RGB]       = { EEBENCH_RGB_SIZE, 1, 1 },                                      // hue, after the mode byte
+    [EB_USER]      = { sizeof(uint32_t), 0, 1 },                                      // the byte holding the flags
+    [EB_RECORDING] = { USAGE_DATABLOCK_OFFSET - RECORDER_DATABLOCK_OFFSET, 4, 4 },    // first edge, after the count
+    [EB_USAGE]     = { EEBENCH_DATABLOCK_OFFSET - USAGE_DATABLOCK_OFFSET, 4, 4 }     // _BASE layer time, after the magic
+};
+
+_Static_assert(EEBENCH_DATABLOCK_OFFSET + EEBENCH_DATABLOCK_SIZE <= EECONFIG_USER_DATA_SIZE, "EECONFIG_USER_DATA_SIZE too small for the EEPROM benchmark");
+_Static_assert(USAGE_DATABLOCK_OFFSET - RECORDER_DATABLOCK_OFFSET <= EEBENCH_DATABLOCK_SIZE, "macro recorder writes don't fit the EEPROM benchmark scratch region");
+_Static_assert(EEBENCH_DATABLOCK_OFFSET - USAGE_DATABLOCK_OFFSET <= EEBENCH_DATABLOCK_SIZE, "usage stats writes don't fit the EEPROM benchmark scratch region");
+
+static bool eebench_active = false;
+static uint16_t eebench_step;           // pattern is step % EB_PATTERNS
+static eebench_stat_t eebench_stats[EB_PATTERNS];
+static uint16_t eebench_compactions;
+static uint16_t eebench_last_compaction; // write count at the last one
+static uint16_t eebench_compact_gap_max; // most writes between two compactions
+static wheel_timer_t eebench_timer;
+
+// Makes one write of the pattern into the scratch region, returns how many cycles the write itself took
+static uint32_t eebench_write(uint8_t pattern) {
+    static uint8_t buffer[EEBENCH_DATABLOCK_SIZE];
+    const eebench_write_t *write = &eebench_writes[pattern];
+    if (!write->length) return 0;
+    eeconfig_read_user_datablock(buffer, EEBENCH_DATABLOCK_OFFSET, write->length);
+    for (uint8_t i = 0; i < write->changed; i++) buffer[write->delta + i] = ~buffer[write->delta + i];
+    uint32_t start = cycle_read();
+    eeconfig_update_user_datablock(buffer, EEBENCH_DATABLOCK_OFFSET, write->length);
+    return cycle_read() - start;
+}
+
+static void eebench_print(void) {
+    #if defined(WEAR_LEVELING_LOGICAL_SIZE) && defined(WEAR_LEVELING_BACKING_SIZE)
+    uprintf("ee bench: logical %u bytes, backing %u bytes\n", WEAR_LEVELING_LOGICAL_SIZE, WEAR_LEVELING_BACKING_SIZE);
+    #endif
+    uint16_t writes = 0;
+    for (uint8_t i = 0; i < EB_PATTERNS; i++) {
+        eebench_stat_t *stat = &eebench_stats[i];
+        writes += stat->writes;
+        uprintf("ee bench: %-9s %u writes, avg %lu us, max %lu us\n", eebench_names[i], stat->writes, stat->writes ? stat->total_us / stat->writes : 0, stat->max_us);
+    }
+    uprintf("ee bench: %u compactions in %u writes, at most %u writes apart\n", eebench_compactions, writes, eebench_compact_gap_max);
+}
+
+static void eebench_run(wheel_timer_t *timer) {
+    uint8_t pattern = eebench_step % EB_PATTERNS;
+
+    uint32_t elapsed = cycles_to_us(eebench_write(pattern));
+
+    eebench_stat_t *stat = &eebench_stats[pattern];
+    stat->writes++;
+    stat->total_us += elapsed;
+    if (elapsed > stat->max_us) stat->max_us = elapsed;
+    if (elapsed >= EEBENCH_COMPACT_US) {
+        uint16_t gap = eebench_step + 1 - eebench_last_compaction;
+        if (gap > eebench_compact_gap_max) eebench_compact_gap_max = gap;
+        eebench_last_compaction = eebench_step + 1;
+        eebench_compactions++;
+    }
+
+    if (++eebench_step < EEBENCH_ROUNDS * EB_PATTERNS * 2) {
+        wheel_arm(timer, EEBENCH_INTERVAL_MS, eebench_run);
+        return;
+    }
+    eebench_active = false;
+    eebench_print();
+}
+
+void eebench_start(void) {
+    if (eebench_active) return;
+    memset(eebench_stats, 0, sizeof(eebench_stats));
+    eebench_step = 0;
+    eebench_compactions = 0;
+    eebench_last_compaction = 0;
+    eebench_compact_gap_max = 0;
+    eebench_active = true;
+    wheel_arm(&eebench_timer, EEBENCH_INTERVAL_MS, eebench_run);
+}
@@ -27,30 +27,39 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
         #define ENCODER_DEFAULTACTIONS_INDEX 0  // can select encoder index if there are multiple encoders
     #endif
 
-    static uint16_t key_timer;
+    // Detents soon after the last one step the volume faster: within 50ms clockwise, within 100ms counter-clockwise.
+    // Each detent opens both windows; the timer closes the clockwise one after 50ms and the other 50ms later.
+    #define VOLUME_WINDOW_UP_MS 50
+    #define VOLUME_WINDOW_DOWN_MS 100
+    static wheel_timer_t volume_timer;
+    static bool volume_fast_up = false;   // the last detent was less than VOLUME_WINDOW_UP_MS ago
+    static bool volume_fast_down = false; // the last detent was less than VOLUME_WINDOW_DOWN_MS ago
+
+    static void volume_window_closed(wheel_timer_t *timer) {
+        if (volume_fast_up) {
+            volume_fast_up = false;
+            wheel_arm(timer, VOLUME_WINDOW_DOWN_MS - VOLUME_WINDOW_UP_MS, volume_window_closed);
+        } else {
+            volume_fast_down = false;
+        }
+    }
 
     void encoder_action_volume(bool clockwise) {
         if (clockwise) {
             tap_code(KC_VOLU);
-            if (timer_elapsed(key_timer) < 50) {
+            if (volume_fast_up) {
               tap_code(KC_VOLU); // if less than 50ms have passed, hit vol up again.
-              key_timer = timer_read();
-            } else {
-              key_timer = timer_read();
-              // do nothing if 50ms or more have passed
             }
         }
         else {
             tap_code(KC_VOLD);
-            if (timer_elapsed(key_timer) < 100) {
+            if (volume_fast_down) {
               tap_code(KC_VOLD); // if less than 100ms have passed, hit vol down twice.
               tap_code(KC_VOLD);
-              key_timer = timer_read();
-            } else {
-              key_timer = timer_read();
-              // do nothing if 100ms or more have passed
             }
         }
+        volume_fast_up = volume_fast_down = true;
+        wheel_arm(&volume_timer, VOLUME_WINDOW_UP_MS, volume_window_closed);
     }
 
     // LAYER HANDLING
@@ -60,6 +69,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
         return selected_layer;
     }
 
+    void set_selected_layer(uint8_t layer) {
+        selected_layer = layer;
+        layer_move(selected_layer);
+    }
+
     void encoder_action_layerchange(bool clockwise) {
         if (clockwise) {
             if(selected_layer  < (DYNAMIC_KEYMAP_LAYER_COUNT - 1)) {
@@ -155,6 +169,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
             encoder_action_rgb_hue(clockwise);
         } else if (mods_state & MOD_BIT(KC_RALT)) { // if holding Left Alt, change rgb brightness
             encoder_action_rgb_brightness(clockwise);
+        } else if (is_macro_tuning()) { // in macro tuning mode, change the selected macro's step delay
+            macro_delay_update(get_tuned_macro(), clockwise);
         } else {
             switch(get_highest_layer(layer_state)) {
             case _FN1:
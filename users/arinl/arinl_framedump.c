@@ -0,0 +1,179 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+#include "rgb_matrix_geometry.h"
+
+// RGB FRAME DUMP
+// RGB_DUMP prints the next RGB_DUMP_FRAMES rendered frames to the console: a text grid of what the effect drew, a
+// grid of the finished frame with the indicators on top, one line per LED the indicators set with its color, and
+// the effect's colors in LED order. The grids are laid out from the LED positions in g_led_config, the LED names
+// come from rgb_matrix_geometry.h.
+// Every color write is seen at the AW20216S driver (rules.mk wraps aw20216s_set_color and _set_color_all, and links
+// without LTO so the wrap holds), so the effect is captured too, not only what the keymap draws. Writes inside the
+// indicator callback of an LED chunk are the indicators', everything before it is the effect's.
+// Each frame is printed with a "time N:" line next to it giving the render time from the DWT cycle counter: each
+// chunk counts from its first LED write to the end of its indicator callback, summed over the frame, with the
+// indicators' share. The scans between chunks and the effect's setup before its first write are not counted.
+// While the dump runs the animation clock is held at RGB_DUMP_TICK: QMK latches g_rgb_timer once per frame before
+// the first chunk renders, and frame_dump_scan() overwrites it from the scan in between, so every dump of the same
+// effect, settings, layer and lock state draws the same frame. Effects that use random numbers or key hits still
+// differ from run to run.
+// Save a dump as a golden file with "qmk console > golden.txt" and compare later dumps with
+// "diff -I 'time [0-9]*:' golden.txt new.txt"; the timing lines are left out of the diff and can be read side by side.
+#ifndef RGB_DUMP_FRAMES
+    #define RGB_DUMP_FRAMES 3
+#endif
+#ifndef RGB_DUMP_TICK
+    #define RGB_DUMP_TICK 0x4000 // animation clock of the dumped frames, in ms
+#endif
+#define RGB_DUMP_GRID_ROWS 7                          // y 0..64 in steps of 11
+#define RGB_DUMP_GRID_COLS (2 + 224 * 2 / 5 + 1 + 2)  // side LEDs in the outer columns
+#define RGB_DUMP_HEX_PER_LINE 8
+
+#define LED_NAME(name, x, y) #name,
+static const char *const dump_led_names[] = { LED_POINTS(LED_NAME) };
+
+_Static_assert(ARRAY_SIZE(dump_led_names) == RGB_MATRIX_LED_COUNT, "rgb_matrix_geometry.h does not match the LED count");
+
+static bool     dump_pending = false;       // started, waiting for the current frame to end
+static uint8_t  dump_frames_left = 0;
+static uint8_t  dump_frame;
+static bool     dump_in_indicators = false; // inside the indicator callback of a chunk
+static bool     dump_chunk_open = false;    // the chunk being rendered has written its first LED
+static uint32_t dump_chunk_start;
+static uint32_t dump_indicator_start;
+static uint32_t dump_render_cycles;
+static uint32_t dump_indicator_cycles;
+static RGB      dump_effect[RGB_MATRIX_LED_COUNT];
+static RGB      dump_colors[RGB_MATRIX_LED_COUNT];
+static uint8_t  dump_lit[(RGB_MATRIX_LED_COUNT + 7) / 8]; // set by the indicators this frame
+static char     dump_grid[RGB_DUMP_GRID_ROWS][RGB_DUMP_GRID_COLS + 1];
+
+void __real_aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+void __real_aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+
+void frame_dump_start(void) {
+    dump_pending = true;
+}
+
+// Called from matrix_scan_user, holds the animation clock while dumping
+void frame_dump_scan(void) {
+    if (dump_pending || dump_frames_left) g_rgb_timer = RGB_DUMP_TICK;
+}
+
+static void frame_dump_mark(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    RGB color = { .r = red, .g = green, .b = blue };
+    dump_colors[index] = color;
+    if (dump_in_indicators) {
+        dump_lit[index / 8] |= 1 << (index % 8);
+        return;
+    }
+    dump_effect[index] = color;
+    if (!dump_chunk_open) {
+        dump_chunk_open = true;
+        dump_chunk_start = cycle_read();
+    }
+}
+
+void __wrap_aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    __real_aw20216s_set_color(index, red, green, blue);
+    if (dump_frames_left && index >= 0 && index < RGB_MATRIX_LED_COUNT) frame_dump_mark(index, red, green, blue);
+}
+
+void __wrap_aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    __real_aw20216s_set_color_all(red, green, blue);
+    if (!dump_frames_left) return;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) frame_dump_mark(i, red, green, blue);
+}
+
+// One character per LED: the strongest channel, upper case when it is close to full brightness
+static char frame_dump_glyph(RGB c) {
+    uint8_t max = c.r > c.g ? (c.r > c.b ? c.r : c.b) : (c.g > c.b ? c.g : c.b);
+    if (!max) return '.';
+    bool r = c.r > max / 2, g = c.g > max / 2, b = c.b > max / 2;
+    char glyph = r && g && b ? 'w' : r && g ? 'y' : r && b ? 'm' : g && b ? 'c' : r ? 'r' : g ? 'g' : 'b';
+    return max >= 0xC0 ? glyph - 'a' + 'A' : glyph;
+}
+
+static void frame_dump_print_grid(const char *title, const RGB *colors) {
+    memset(dump_grid, ' ', sizeof(dump_grid));
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t col = g_led_config.point[i].x * 2 / 5 + 2;
+        if (g_led_config.flags[i] & LED_FLAG_UNDERGLOW) col = g_led_config.point[i].x < 112 ? 0 : RGB_DUMP_GRID_COLS - 1;
+        dump_grid[(g_led_config.point[i].y + 5) / 11][col] = frame_dump_glyph(colors[i]);
+    }
+    uprintf("%s\n", title);
+    for (uint8_t row = 0; row < RGB_DUMP_GRID_ROWS; row++) {
+        dump_grid[row][RGB_DUMP_GRID_COLS] = '\0';
+        uprintf("|%s|\n", dump_grid[row]);
+    }
+}
+
+static void frame_dump_print(void) {
+    uprintf("frame %u\n", dump_frame);
+    uprintf("time %u: render %lu us, indicators %lu us\n", dump_frame, cycles_to_us(dump_render_cycles), cycles_to_us(dump_indicator_cycles));
+    frame_dump_print_grid("effect", dump_effect);
+    frame_dump_print_grid("frame", dump_colors);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (dump_lit[i / 8] & (1 << (i % 8))) uprintf("  %-5s %02X%02X%02X\n", dump_led_names[i], dump_colors[i].r, dump_colors[i].g, dump_colors[i].b);
+    }
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (i % RGB_DUMP_HEX_PER_LINE == 0) uprintf("  %2u:", i);
+        uprintf(" %02X%02X%02X", dump_effect[i].r, dump_effect[i].g, dump_effect[i].b);
+        if (i % RGB_DUMP_HEX_PER_LINE == RGB_DUMP_HEX_PER_LINE - 1 || i == RGB_MATRIX_LED_COUNT - 1) uprintf("\n");
+    }
+}
+
+// Called at the start of the indicator callback
+void frame_dump_begin(uint8_t led_min, uint8_t led_max) {
+    if (!dump_frames_left) return;
+    if (led_min == 0) memset(dump_lit, 0, sizeof(dump_lit));
+    dump_indicator_start = cycle_read();
+    if (!dump_chunk_open) { // the effect wrote nothing in this chunk
+        dump_chunk_open = true;
+        dump_chunk_start = dump_indicator_start;
+    }
+    dump_in_indicators = true;
+}
+
+// Called at the end of the indicator callback, prints once the last LED chunk of the frame is done
+void frame_dump_end(uint8_t led_min, uint8_t led_max) {
+    if (dump_pending && led_max >= RGB_MATRIX_LED_COUNT) { // capture whole frames only, from the next one on
+        dump_pending = false;
+        dump_frames_left = RGB_DUMP_FRAMES;
+        dump_frame = 0;
+        dump_chunk_open = false;
+        dump_render_cycles = 0;
+        dump_indicator_cycles = 0;
+        return;
+    }
+    if (!dump_frames_left) return;
+    uint32_t now = cycle_read();
+    dump_indicator_cycles += now - dump_indicator_start;
+    dump_render_cycles += now - dump_chunk_start;
+    dump_chunk_open = false;
+    dump_in_indicators = false;
+    if (led_max < RGB_MATRIX_LED_COUNT) return;
+
+    frame_dump_print();
+    dump_frame++;
+    dump_frames_left--;
+    dump_render_cycles = 0;
+    dump_indicator_cycles = 0;
+}
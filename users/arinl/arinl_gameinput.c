@@ -0,0 +1,105 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// GAME INPUTS
+// Turns one physical press into a timed press pattern for keys listed in the keymap's game_inputs[] table.
+//   GI_PLINK: press, release after N frames, press again one frame later, then follow the physical key
+//   GI_HOLD:  press, and keep the key registered for at least N frames even on a quick tap
+// All timing runs on the timer wheel, nothing here blocks the scan loop.
+enum game_input_phases {
+    GI_IDLE,
+    GI_FIRST_PRESS, // plink: first press registered, waiting to release
+    GI_GAP,         // plink: released between the two presses
+    GI_MIN_HOLD,    // registered, waiting out the minimum hold
+    GI_FOLLOW       // pattern done, release with the physical key
+};
+
+typedef struct {
+    wheel_timer_t timer; // must stay first, the wheel callback casts back to the state
+    uint8_t       index; // entry in game_inputs[]
+    uint8_t       phase;
+    bool          held;  // physical key state
+} game_input_state_t;
+
+static game_input_state_t game_input_states[GAME_INPUT_MAX];
+
+uint16_t game_frames_to_ms(uint8_t frames) {
+    return ((uint32_t)frames * 1000 + GAME_FRAME_RATE / 2) / GAME_FRAME_RATE;
+}
+
+static void game_input_step(wheel_timer_t *timer) {
+    game_input_state_t *state = (game_input_state_t *)timer;
+    const game_input_t *input = &game_inputs[state->index];
+
+    switch (state->phase) {
+    case GI_FIRST_PRESS:
+        key_owner_tap(input->keycode, KO_GAME, false);
+        state->phase = GI_GAP;
+        wheel_arm(&state->timer, game_frames_to_ms(1), game_input_step);
+        break;
+    case GI_GAP:
+        key_owner_tap(input->keycode, KO_GAME, true);
+        state->phase = GI_MIN_HOLD; // the second press must also be seen for a full frame
+        wheel_arm(&state->timer, game_frames_to_ms(1), game_input_step);
+        break;
+    case GI_MIN_HOLD:
+        if (state->held) {
+            state->phase = GI_FOLLOW;
+        } else {
+            key_owner_tap(input->keycode, KO_GAME, false);
+            state->phase = GI_IDLE;
+        }
+        break;
+    }
+}
+
+bool process_game_input(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_BASIC_KEYCODE(keycode)) return true;
+
+    uint8_t layer = get_highest_layer(layer_state);
+    for (uint8_t i = 0; i < game_inputs_count && i < GAME_INPUT_MAX; i++) {
+        const game_input_t *input = &game_inputs[i];
+        game_input_state_t *state = &game_input_states[i];
+        if (input->keycode != keycode) continue;
+
+        if (record->event.pressed) {
+            if (state->phase != GI_IDLE) { // pressed again while the pattern is still running
+                state->held = true;
+                return false;
+            }
+            if (input->layer != layer) continue;
+            state->index = i;
+            state->held = true;
+            key_owner_tap(input->keycode, KO_GAME, true);
+            state->phase = input->mode == GI_PLINK ? GI_FIRST_PRESS : GI_MIN_HOLD;
+            wheel_arm(&state->timer, game_frames_to_ms(input->frames), game_input_step);
+            return false;
+        }
+
+        if (state->phase == GI_IDLE) continue;
+        state->held = false;
+        if (state->phase == GI_FOLLOW) {
+            key_owner_tap(input->keycode, KO_GAME, false);
+            state->phase = GI_IDLE;
+        } // otherwise the running pattern finishes and releases on its own
+        return false;
+    }
+    return true;
+}
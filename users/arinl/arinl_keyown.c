@@ -0,0 +1,132 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// KEY OWNERSHIP
+// One byte per keycode records who is holding the key down: a count of physical switches (a macro key's plain
+// fallback and the NumLock sync's tap count as one) and a bit for each engine. The host sees the key down while anyone holds it and up once
+// the last owner lets go, so a macro or turbo releasing a key can't drop one the player still holds, and the
+// player releasing can't cut off an engine mid-pattern.
+// Macros are the one owner allowed to pull a held key up (motion inputs release the held direction): a macro
+// release sets KO_SUPPRESS, and macro_finish() clears it so the key goes back to what the switches say.
+// Only edges that change what the host sees touch the report, and key_owner_flush() sends it once.
+// Physical modifiers are counted like any other key, so an engine releasing shift leaves the player's shift down.
+// QMK's clear_keyboard() empties the report behind the table's back on wakeup, so the table is cleared with it.
+static uint8_t key_owners[256];
+static uint8_t key_host_down[256 / 8]; // what the last report said
+static bool key_report_dirty = false;
+
+static bool key_owner_wants_down(uint8_t owners) {
+    return (owners & ~KO_SUPPRESS) && !(owners & KO_SUPPRESS);
+}
+
+static void key_owner_update(uint8_t keycode) {
+    bool down = key_owner_wants_down(key_owners[keycode]);
+    bool host = key_host_down[keycode / 8] & (1 << (keycode % 8));
+    if (down == host) return; // redundant edge, nothing to send
+
+    if (IS_MODIFIER_KEYCODE(keycode)) {
+        if (down) {
+            add_mods(MOD_BIT(keycode));
+        } else {
+            del_mods(MOD_BIT(keycode));
+        }
+    } else if (down) {
+        add_key(keycode);
+    } else {
+        del_key(keycode);
+    }
+    key_host_down[keycode / 8] ^= 1 << (keycode % 8);
+    key_report_dirty = true;
+}
+
+// Changes one owner's hold on the key; the report goes out with the next key_owner_flush()
+void key_owner_set(uint8_t keycode, uint8_t owner, bool down) {
+    uint8_t *owners = &key_owners[keycode];
+    if (owner == KO_PHYSICAL) {
+        uint8_t count = *owners & KO_PHYSICAL_MASK;
+        if (down && count < KO_PHYSICAL_MASK) count++;
+        if (!down && count > 0) count--;
+        *owners = (*owners & ~KO_PHYSICAL_MASK) | count;
+        if (down) *owners &= ~KO_SUPPRESS; // a fresh press beats a macro's release
+    } else if (down) {
+        *owners = (*owners | owner) & ~(owner == KO_MACRO ? KO_SUPPRESS : 0);
+    } else {
+        *owners &= ~owner;
+        if (owner == KO_MACRO && (*owners & ~KO_SUPPRESS)) *owners |= KO_SUPPRESS; // release it even if still held
+    }
+    if (!(*owners & ~KO_SUPPRESS)) *owners = 0; // suppressing a key nobody holds means nothing
+    key_owner_update(keycode);
+}
+
+// Sends the report if any key changed since the last flush, returns true if it did
+bool key_owner_flush(void) {
+    if (!key_report_dirty) return false;
+    key_report_dirty = false;
+    send_keyboard_report();
+    return true;
+}
+
+void key_owner_tap(uint8_t keycode, uint8_t owner, bool down) {
+    key_owner_set(keycode, owner, down);
+    key_owner_flush();
+}
+
+// Drops the owner from every key (macros also lift their suppressions) and sends what changed
+void key_owner_release_all(uint8_t owner) {
+    uint8_t clear = owner == KO_MACRO ? owner | KO_SUPPRESS : owner;
+    for (uint16_t keycode = 0; keycode < 256; keycode++) {
+        if (!(key_owners[keycode] & clear)) continue;
+        key_owners[keycode] &= ~clear;
+        key_owner_update(keycode);
+    }
+    key_owner_flush();
+}
+
+bool key_owner_is_down(uint8_t keycode) {
+    return key_host_down[keycode / 8] & (1 << (keycode % 8));
+}
+
+// Nothing owned and nothing registered with the host
+bool key_owner_is_idle(void) {
+    for (uint16_t keycode = 0; keycode < 256; keycode++) {
+        if (key_owners[keycode] || key_owner_is_down(keycode)) return false;
+    }
+    return true;
+}
+
+// Forgets every owner, for after clear_keyboard() has emptied the report
+void key_owner_clear(void) {
+    memset(key_owners, 0, sizeof(key_owners));
+    memset(key_host_down, 0, sizeof(key_host_down));
+    key_report_dirty = false;
+}
+
+// Physical basic keys and modifiers end up here instead of QMK's register_code(). They go through keycode_config()
+// like QMK's own path, so Win Lock (no_gui) and the magic swaps still apply; a key Win Lock maps to nothing is
+// still released by its own keycode, in case it was pressed before the lock.
+bool key_owner_record(uint16_t keycode, keyrecord_t *record) {
+    uint16_t mapped = keycode_config(keycode);
+    if (mapped == KC_NO) {
+        if (record->event.pressed) return false;
+        mapped = keycode;
+    }
+    key_owner_tap(mapped, KO_PHYSICAL, record->event.pressed);
+    return false;
+}
@@ -0,0 +1,170 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// MACRO ENGINE
+// Plays macro_step_t sequences through the key ownership table. Each report is sent once, with its modifier mask
+// already applied, instead of one report per key and mod change as SEND_STRING does, and steps that don't change
+// what the host sees (pressing a key the player already holds) send nothing.
+// With report coalescing on, steps that are due in the same poll slot (delay below get_macro_poll_slot(), one or
+// more host polling intervals) share a report as long as they touch different keys and want the same modifier
+// mask. MS_NOSHIFT masks weak mods too, so a shifted keycode the player holds can't leak shift into the step.
+// macro_play() and macro_finish() only queue work. The first report goes out right away, the rest are paced by
+// the timer wheel, so the scan loop keeps running while a macro plays and key events are no longer held back
+// until it ends. A macro key pressed while another is still playing queues up behind it. A macro key's sequences
+// are staged by macro_play() and only queued by its macro_finish(), all of them with the finish or none: when the
+// queue can't take the whole key it is dropped, so no key is left latched for want of its finish.
+// A macro release of a held key pulls it up for the host; macro_finish() at the end of the whole macro key hands
+// every key back to the switches, so a direction the player still holds is pressed again and nothing is left
+// latched that the player has let go of.
+// A macro with speculation on sends its first step from the raw press edge (see macro_spec_scan), a debounce
+// window before the macro key event arrives. Its queued sequence then skips that step and only waits out what is
+// left of its delay; if debounce rejects the edge, macro_spec_cancel() takes the step back. If the key picks another
+// sequence than the one speculated on (the direction changed in between), the step is taken back before the first
+// sequence starts.
+#ifndef MACRO_QUEUE_SIZE
+    #define MACRO_QUEUE_SIZE 16 // sequences, a macro key queues up to 6 including its finish
+#endif
+
+typedef struct {
+    const macro_step_t *steps; // NULL marks a macro_finish()
+    uint8_t count;
+    uint8_t delay;
+} macro_job_t;
+
+static macro_job_t macro_queue[MACRO_QUEUE_SIZE];
+static uint8_t macro_queue_head = 0;
+static uint8_t macro_queue_len = 0;
+static uint8_t macro_queue_staged = 0; // after the queue, waiting for macro_finish()
+static bool macro_queue_full = false;  // a sequence of the key being staged didn't fit
+static uint8_t macro_next_step = 0;    // in the job at the head of the queue
+static wheel_timer_t macro_timer;
+
+static const macro_step_t *spec_step; // sent ahead of the debounced press
+static uint16_t spec_time;
+
+static bool macro_step_compatible(const macro_step_t *steps, uint8_t first, uint8_t next) {
+    if ((steps[next].flags & MS_NOSHIFT) != (steps[first].flags & MS_NOSHIFT)) return false;
+    for (uint8_t i = first; i < next; i++) {
+        if (steps[i].keycode == steps[next].keycode) return false; // the host would never see the first edge
+    }
+    return true;
+}
+
+// Sends one report starting at steps[first], returns the index of the first step left unsent
+static uint8_t macro_send_report(const macro_step_t *steps, uint8_t first, uint8_t count, bool coalesce) {
+    uint8_t i = first;
+    do {
+        key_owner_set(steps[i].keycode, KO_MACRO, steps[i].flags & MS_DOWN);
+        i++;
+    } while (coalesce && i < count && macro_step_compatible(steps, first, i));
+
+    if (steps[first].flags & MS_NOSHIFT) {
+        uint8_t mods = get_mods();
+        uint8_t weak_mods = get_weak_mods();
+        del_mods(MOD_MASK_SHIFT);
+        del_weak_mods(MOD_MASK_SHIFT);
+        key_owner_flush();
+        set_mods(mods); // restored silently, the next report carries them again
+        set_weak_mods(weak_mods);
+    } else {
+        key_owner_flush();
+    }
+    return i;
+}
+
+// Works through the queue until something has to wait
+static void macro_run(wheel_timer_t *timer) {
+    while (macro_queue_len) {
+        const macro_job_t *job = &macro_queue[macro_queue_head];
+        uint8_t slot = get_macro_poll_slot();
+        bool coalesce = user_config.macro_coalesce && job->delay < slot;
+        uint8_t wait = 0;
+
+        if (!job->steps) {
+            spec_step = NULL;
+            key_owner_release_all(KO_MACRO);
+        } else if (macro_next_step == 0 && spec_step == job->steps) { // the first step is already out
+            uint16_t elapsed = timer_elapsed(spec_time);
+            spec_step = NULL;
+            macro_next_step = 1;
+            if (!coalesce && job->delay > elapsed) wait = job->delay - elapsed;
+        } else if (macro_next_step == 0 && spec_step) {
+            spec_step = NULL; // the wrong sequence went out early, and it is the only macro step out
+            key_owner_release_all(KO_MACRO);
+        } else if (macro_next_step < job->count) {
+            macro_next_step = macro_send_report(job->steps, macro_next_step, job->count, coalesce);
+            wait = coalesce ? slot : job->delay; // let the host poll this report before the next one replaces it
+        }
+
+        if (macro_next_step >= job->count && !wait) {
+            macro_queue_head = (macro_queue_head + 1) % MACRO_QUEUE_SIZE;
+            macro_queue_len--;
+            macro_next_step = 0;
+        }
+        if (wait) {
+            wheel_arm(&macro_timer, wait, macro_run);
+            return;
+        }
+    }
+}
+
+void macro_play(const macro_step_t *steps, uint8_t count, uint8_t delay) {
+    if (macro_queue_len + macro_queue_staged >= MACRO_QUEUE_SIZE - 1) { // the finish needs a slot too
+        macro_queue_full = true;
+        return;
+    }
+    macro_queue[(macro_queue_head + macro_queue_len + macro_queue_staged) % MACRO_QUEUE_SIZE] = (macro_job_t){ .steps = steps, .count = count, .delay = delay };
+    macro_queue_staged++;
+}
+
+// Called once the macro key has staged all its sequences, queues them with the finish
+void macro_finish(void) {
+    if (macro_queue_full) { // too many macro keys at once, drop this one whole
+        macro_queue_staged = 0;
+        macro_queue_full = false;
+        macro_spec_cancel();
+        return;
+    }
+    macro_queue[(macro_queue_head + macro_queue_len + macro_queue_staged) % MACRO_QUEUE_SIZE] = (macro_job_t){ .steps = NULL };
+    macro_queue_len += macro_queue_staged + 1;
+    macro_queue_staged = 0;
+    if (!wheel_is_armed(&macro_timer)) macro_run(&macro_timer); // idle, start right away
+}
+
+bool macro_is_playing(void) {
+    return macro_queue_len;
+}
+
+void macro_speculate(const macro_step_t *step) {
+    spec_step = step;
+    spec_time = timer_read();
+    macro_send_report(step, 0, 1, false);
+}
+
+bool macro_is_speculating(void) {
+    return spec_step;
+}
+
+// Takes back a speculative first step the macro key event didn't claim
+void macro_spec_cancel(void) {
+    if (!spec_step) return;
+    spec_step = NULL;
+    if (!macro_is_playing()) key_owner_release_all(KO_MACRO);
+}
@@ -0,0 +1,113 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// NUMLOCK SYNC
+// activate_numlock() only records the wanted state. The toggle is tapped from the timer wheel, never from inside
+// the caller, and is checked against the LED report the host sends back. If the host doesn't answer within
+// NUMLOCK_VERIFY_MS the tap is retried, up to NUMLOCK_RETRIES times. A new toggle is only sent once the previous
+// one is confirmed or timed out, so flipping _FN2 on and off quickly can't stack up toggles.
+#ifndef NUMLOCK_TAP_MS
+    #define NUMLOCK_TAP_MS 10       // how long KC_NUM is held
+#endif
+#ifndef NUMLOCK_VERIFY_MS
+    #define NUMLOCK_VERIFY_MS 250   // wait for the host LED report after the tap
+#endif
+#ifndef NUMLOCK_RETRIES
+    #define NUMLOCK_RETRIES 2
+#endif
+
+enum numlock_phases {
+    NL_IDLE,
+    NL_PRESS,    // waiting to press KC_NUM
+    NL_RELEASE,  // KC_NUM held
+    NL_VERIFY    // tapped, waiting for the host to report the new state
+};
+
+static uint8_t numlock_phase = NL_IDLE;
+static bool numlock_target;
+static bool numlock_sent_from;      // host NumLock state when the toggle was sent
+static uint8_t numlock_tries;
+static wheel_timer_t numlock_timer;
+
+static void numlock_step(wheel_timer_t *timer);
+
+static void numlock_toggle(void) {
+    numlock_phase = NL_PRESS;
+    wheel_arm(&numlock_timer, 1, numlock_step);
+}
+
+static void numlock_step(wheel_timer_t *timer) {
+    switch (numlock_phase) {
+    case NL_PRESS:
+        numlock_sent_from = host_keyboard_led_state().num_lock;
+        if (numlock_sent_from == numlock_target) { // flipped back before the tap went out
+            numlock_phase = NL_IDLE;
+            break;
+        }
+        key_owner_tap(KC_NUM, KO_PHYSICAL, true); // through the ownership table, so its host state stays right
+        numlock_phase = NL_RELEASE;
+        wheel_arm(&numlock_timer, NUMLOCK_TAP_MS, numlock_step);
+        break;
+    case NL_RELEASE:
+        key_owner_tap(KC_NUM, KO_PHYSICAL, false);
+        numlock_phase = NL_VERIFY;
+        wheel_arm(&numlock_timer, NUMLOCK_VERIFY_MS, numlock_step);
+        break;
+    case NL_VERIFY: // no answer from the host
+        if (host_keyboard_led_state().num_lock == numlock_target) {
+            numlock_phase = NL_IDLE;
+        } else if (numlock_tries++ < NUMLOCK_RETRIES) {
+            numlock_toggle();
+        } else {
+            numlock_phase = NL_IDLE; // give up, the next activate_numlock() starts over
+        }
+        break;
+    }
+}
+
+// Called from led_update_user with every LED report from the host
+void numlock_led_update(led_t led_state) {
+    if (numlock_phase != NL_VERIFY || led_state.num_lock == numlock_sent_from) return; // not our toggle (yet)
+    wheel_cancel(&numlock_timer);
+    if (led_state.num_lock == numlock_target) {
+        numlock_phase = NL_IDLE;
+    } else { // the target flipped while the toggle was in flight
+        numlock_tries = 0;
+        numlock_toggle();
+    }
+}
+
+// Turn on/off NUM LOCK if current state is different
+void activate_numlock(bool turn_on) {
+    numlock_target = turn_on;
+    if (numlock_phase != NL_IDLE) return; // the toggle in flight checks the new target when it lands
+    if (host_keyboard_led_state().num_lock != turn_on) {
+        numlock_tries = 0;
+        numlock_toggle();
+    }
+}
+
+bool get_numlock_target(void) {
+    return numlock_target;
+}
+
+bool numlock_is_busy(void) {
+    return numlock_phase != NL_IDLE;
+}
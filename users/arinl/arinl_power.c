@@ -0,0 +1,95 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// RGB POWER LIMIT
+// Estimates the LED current of every frame and dims the output only when it goes over RGB_POWER_BUDGET_MA, so
+// normal frames keep full brightness and only bright white states get pulled down.
+// Effects get their colors from rgb_matrix_hsv_to_rgb(), which is weak in QMK and overridden here: each call adds
+// its unscaled channel sum to the frame total. Effects like solid color convert once for many LEDs, so the total
+// is taken as the average color times the LED count. The keymap adds its cached indicator overlay sum at the end
+// of the frame, along with how many LEDs the overlay covers, since those replace what the effect drew there. The
+// scale worked out from one frame is applied to the next, dropping at once and recovering by
+// RGB_POWER_RECOVER_STEP per frame.
+// The AW20216S drives each channel at 40 mA x GCC/256 x SL/256 while its switch line is on, and scans its 12
+// switch lines one at a time, so a channel at full PWM averages a twelfth of that: about 1.1 mA with the board's
+// global current and scaling of 150. Full white on all 98 LEDs comes to about 340 mA; the default amber at half
+// brightness about 90 mA, which the default budget leaves alone.
+// Limit: only colors that go through rgb_matrix_hsv_to_rgb() and the keymap's indicator overlay are counted and
+// scaled. Raw RGB writes bypass both, such as DIGITAL_RAIN (green straight from its frame buffer),
+// rgb_matrix_set_color_all() and any other rgb_matrix_set_color() with fixed values. In the arinl keymap those are
+// the rain, at most one channel per LED (about 110 mA), and night mode's all-off, so the budget holds there; a
+// keymap adding bright raw writes has to pass them through rgb_power_scale8() and its overlay sum itself.
+#ifndef RGB_POWER_BUDGET_MA
+    #define RGB_POWER_BUDGET_MA 250        // LED share of a 500 mA port, the MCU and hub ports need the rest
+#endif
+#ifndef AW20216S_GLOBAL_CURRENT_MAX
+    #define AW20216S_GLOBAL_CURRENT_MAX 150
+#endif
+#ifndef AW20216S_SCALING_MAX
+    #define AW20216S_SCALING_MAX 150
+#endif
+#ifndef RGB_POWER_CHANNEL_UA
+    #define RGB_POWER_CHANNEL_UA (40000UL * AW20216S_GLOBAL_CURRENT_MAX / 256 * AW20216S_SCALING_MAX / 256 / 12) // one LED channel at full PWM, averaged over the scan
+#endif
+#ifndef RGB_POWER_RECOVER_STEP
+    #define RGB_POWER_RECOVER_STEP 4       // per frame, out of 256
+#endif
+#define RGB_POWER_BUDGET ((uint32_t)RGB_POWER_BUDGET_MA * 1000 * 255 / RGB_POWER_CHANNEL_UA) // in channel PWM units
+
+static uint32_t power_effect_sum;      // unscaled channel sum of this frame's conversions
+static uint16_t power_effect_calls;
+static uint16_t power_scale = 256;     // Q8, applied to the frame being drawn
+static uint32_t power_demand;          // last frame's estimate, channel PWM units
+
+uint8_t rgb_power_scale8(uint8_t value) {
+    return power_scale >= 256 ? value : (value * power_scale) >> 8;
+}
+
+uint16_t get_rgb_power_ma(void) {
+    return power_demand * RGB_POWER_CHANNEL_UA / 255 / 1000;
+}
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    RGB rgb = hsv_to_rgb(hsv);
+    power_effect_sum += rgb.r + rgb.g + rgb.b;
+    power_effect_calls++;
+    rgb.r = rgb_power_scale8(rgb.r);
+    rgb.g = rgb_power_scale8(rgb.g);
+    rgb.b = rgb_power_scale8(rgb.b);
+    return rgb;
+}
+
+// Called from the indicator callback once the last LED chunk of a frame is drawn
+void rgb_power_frame_end(uint32_t overlay_sum, uint8_t overlay_leds, bool effect_visible) {
+    uint32_t demand = overlay_sum;
+    if (effect_visible && power_effect_calls && overlay_leds < RGB_MATRIX_LED_COUNT) {
+        demand += power_effect_sum / power_effect_calls * (RGB_MATRIX_LED_COUNT - overlay_leds);
+    }
+    power_effect_sum = 0;
+    power_effect_calls = 0;
+    power_demand = demand;
+
+    uint16_t target = demand > RGB_POWER_BUDGET ? RGB_POWER_BUDGET * 256 / demand : 256;
+    if (target < power_scale) {
+        power_scale = target; // over budget, dim right away
+    } else if (power_scale < target) {
+        power_scale = power_scale + RGB_POWER_RECOVER_STEP < target ? power_scale + RGB_POWER_RECOVER_STEP : target;
+    }
+}
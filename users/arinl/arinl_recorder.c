@@ -0,0 +1,150 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// MACRO RECORDER
+// Captures key edges with their millisecond timestamps and replays them with the same (or scaled) timing on the
+// timer wheel. Unlike QMK dynamic macros the timing survives, and the recording can be snapped to game frames
+// and kept in the user EEPROM datablock.
+typedef struct {
+    uint16_t time;    // ms since the first recorded edge
+    uint8_t  keycode;
+    uint8_t  pressed;
+} recorder_event_t;
+
+typedef struct {
+    uint8_t          count;
+    uint8_t          reserved[3];
+    recorder_event_t events[MACRO_RECORDER_SIZE];
+} recorder_store_t;
+
+_Static_assert(sizeof(recorder_store_t) <= EECONFIG_USER_DATA_SIZE, "EECONFIG_USER_DATA_SIZE too small for the macro recorder");
+_Static_assert(RECORDER_DATABLOCK_OFFSET + sizeof(recorder_store_t) <= USAGE_DATABLOCK_OFFSET, "macro recorder overlaps the usage stats in the datablock");
+
+static recorder_store_t recorder;
+static uint16_t recorder_start;
+static bool recorder_recording = false;
+static uint8_t recorder_scale = MACRO_RECORDER_SCALE;
+
+static wheel_timer_t recorder_timer;
+static uint8_t recorder_next;            // next event to play
+
+bool recorder_is_recording(void) {
+    return recorder_recording;
+}
+
+bool recorder_is_playing(void) {
+    return wheel_is_armed(&recorder_timer);
+}
+
+static void recorder_show_state(void) {
+    indicator_state_set(IND_RECORDING, recorder_recording);
+    indicator_state_set(IND_PLAYING, recorder_is_playing());
+}
+
+uint8_t get_recorder_scale(void) {
+    return recorder_scale;
+}
+
+// Replay timing in MACRO_RECORDER_SCALE_STEP percent steps, takes effect from the next replayed edge
+void recorder_update_scale(bool slower) {
+    if (slower && recorder_scale <= MACRO_RECORDER_SCALE_MAX - MACRO_RECORDER_SCALE_STEP) recorder_scale += MACRO_RECORDER_SCALE_STEP;
+    if (!slower && recorder_scale >= MACRO_RECORDER_SCALE_MIN + MACRO_RECORDER_SCALE_STEP) recorder_scale -= MACRO_RECORDER_SCALE_STEP;
+}
+
+void recorder_init(void) {
+    eeconfig_read_user_datablock(&recorder, RECORDER_DATABLOCK_OFFSET, sizeof(recorder));
+    if (recorder.count > MACRO_RECORDER_SIZE) recorder.count = 0; // blank or stale datablock
+}
+
+static void recorder_play_step(wheel_timer_t *timer) {
+    recorder_event_t *event = &recorder.events[recorder_next];
+    key_owner_tap(event->keycode, KO_RECORDER, event->pressed);
+
+    if (++recorder_next >= recorder.count) {
+        key_owner_release_all(KO_RECORDER); // never leave a key stuck if the recording ended mid-press
+        recorder_show_state();
+        return;
+    }
+    uint32_t delay = (uint32_t)(recorder.events[recorder_next].time - event->time) * recorder_scale / 100;
+    wheel_arm(&recorder_timer, delay > UINT16_MAX ? UINT16_MAX : delay, recorder_play_step);
+}
+
+static void recorder_stop_playing(void) {
+    wheel_cancel(&recorder_timer);
+    key_owner_release_all(KO_RECORDER);
+}
+
+// Snaps every timestamp to the nearest game frame so replays line up with the game's input polling
+static void recorder_quantize(void) {
+    for (uint8_t i = 0; i < recorder.count; i++) {
+        uint32_t frame = ((uint32_t)recorder.events[i].time * GAME_FRAME_RATE + 500) / 1000;
+        recorder.events[i].time = frame * 1000 / GAME_FRAME_RATE;
+    }
+}
+
+static void recorder_capture(uint8_t keycode, keyrecord_t *record) {
+    if (recorder.count == 0) recorder_start = record->event.time;
+    uint16_t time = TIMER_DIFF_16(record->event.time, recorder_start);
+    if (recorder.count >= MACRO_RECORDER_SIZE || (recorder.count && time < recorder.events[recorder.count - 1].time)) {
+        recorder_recording = false; // buffer full or the 16 bit timestamp wrapped
+        recorder_show_state();
+        return;
+    }
+    recorder.events[recorder.count++] = (recorder_event_t){ .time = time, .keycode = keycode, .pressed = record->event.pressed };
+}
+
+bool process_recorder(uint16_t keycode, keyrecord_t *record) {
+    switch (keycode) {
+    case MR_REC:
+        if (record->event.pressed) {
+            if (recorder_is_playing()) recorder_stop_playing();
+            recorder_recording = !recorder_recording;
+            if (recorder_recording) recorder.count = 0;
+            recorder_show_state();
+        }
+        return false;
+    case MR_PLAY:
+        if (record->event.pressed && !recorder_recording) {
+            if (recorder_is_playing()) {
+                recorder_stop_playing();
+            } else if (recorder.count) {
+                recorder_next = 0;
+                wheel_arm(&recorder_timer, 1, recorder_play_step);
+            }
+            recorder_show_state();
+        }
+        return false;
+    case MR_FAST:
+    case MR_SLOW:
+        if (record->event.pressed) recorder_update_scale(keycode == MR_SLOW);
+        return false;
+    case MR_QNTZ:
+        if (record->event.pressed && !recorder_recording && !recorder_is_playing()) recorder_quantize();
+        return false;
+    case MR_SAVE:
+        if (record->event.pressed && !recorder_recording) {
+            eeconfig_update_user_datablock(&recorder, RECORDER_DATABLOCK_OFFSET, offsetof(recorder_store_t, events) + recorder.count * sizeof(recorder_event_t));
+        }
+        return false;
+    }
+
+    if (recorder_recording && (IS_BASIC_KEYCODE(keycode) || IS_MODIFIER_KEYCODE(keycode))) recorder_capture(keycode, record);
+    return true;
+}
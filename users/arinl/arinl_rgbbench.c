@@ -0,0 +1,137 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// RGB EFFECT BENCHMARK
+// RGB_BNCH renders every compiled-in effect for RGB_BENCH_FRAMES frames on the real LED layout and prints the
+// cost to the console (qmk console). The scan loop is first timed with RGB off as a baseline. Whatever time
+// an effect adds on top of that, spread over the frames it drew, is its CPU time per frame.
+// Indicators are skipped while the benchmark runs so only the effect itself is measured. If RGB is turned off
+// (RGB_TOG, the idle timeout, USB suspend) or an effect stops drawing frames, the benchmark gives up and hands the
+// indicators back rather than waiting for frames that never come.
+// Flash per effect can't be measured from inside the firmware, users/arinl/rgb_effect_sizes.sh gets it from
+// builds with each effect left out.
+#ifndef RGB_BENCH_FRAMES
+    #define RGB_BENCH_FRAMES 200 // measured frames per effect
+#endif
+#ifndef RGB_BENCH_SETTLE
+    #define RGB_BENCH_SETTLE 8 // frames skipped after switching effect (first frame does the effect init)
+#endif
+#ifndef RGB_BENCH_BASELINE_MS
+    #define RGB_BENCH_BASELINE_MS 1000
+#endif
+#ifndef RGB_BENCH_TIMEOUT_MS
+    #define RGB_BENCH_TIMEOUT_MS 10000 // longest one effect may take to draw its frames
+#endif
+
+static bool     bench_active = false;
+static uint8_t  bench_mode;          // effect being measured, RGB_MATRIX_NONE while measuring the baseline
+static uint8_t  bench_saved_mode;
+static bool     bench_saved_enabled;
+static uint16_t bench_frames;
+static uint32_t bench_scans;
+static uint32_t bench_start;
+static uint32_t bench_baseline_ns;   // scan time with RGB off
+static wheel_timer_t bench_timer;
+
+bool is_rgb_bench_running(void) {
+    return bench_active;
+}
+
+static void rgb_bench_restart_window(void) {
+    bench_frames = 0;
+    bench_scans = 0;
+    bench_start = timer_read32();
+}
+
+static void rgb_bench_finish(const char *reason) {
+    bench_active = false;
+    wheel_cancel(&bench_timer);
+    bool enabled = rgb_matrix_is_enabled();
+    rgb_matrix_mode_noeeprom(bench_saved_mode);
+    if (!bench_saved_enabled || !enabled) rgb_matrix_disable_noeeprom(); // RGB turned off during the run stays off
+    uprintf("rgb bench: %s\n", reason);
+}
+
+static void rgb_bench_timeout(wheel_timer_t *timer) {
+    uprintf("rgb bench: mode %u drew %u frames in %u ms\n", bench_mode, bench_frames, RGB_BENCH_TIMEOUT_MS);
+    rgb_bench_finish("aborted, no frames");
+}
+
+static void rgb_bench_next_effect(void) {
+    if (++bench_mode >= RGB_MATRIX_EFFECT_MAX) {
+        rgb_bench_finish("done");
+        return;
+    }
+    rgb_matrix_mode_noeeprom(bench_mode);
+    rgb_bench_restart_window();
+    wheel_arm(&bench_timer, RGB_BENCH_TIMEOUT_MS, rgb_bench_timeout);
+}
+
+static void rgb_bench_baseline_done(wheel_timer_t *timer) {
+    uint32_t elapsed_us = timer_elapsed32(bench_start) * 1000;
+    bench_baseline_ns = bench_scans ? (uint64_t)elapsed_us * 1000 / bench_scans : 0;
+    uprintf("rgb bench: baseline %lu ns/scan, %u leds\n", bench_baseline_ns, RGB_MATRIX_LED_COUNT);
+    #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
+    uprintf("rgb bench: framebuffer effects share %u bytes RAM\n", sizeof(g_rgb_frame_buffer));
+    #endif
+    #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    uprintf("rgb bench: reactive effects share %u bytes RAM\n", sizeof(g_last_hit_tracker));
+    #endif
+    rgb_matrix_enable_noeeprom();
+    rgb_bench_next_effect();
+}
+
+void rgb_bench_start(void) {
+    if (bench_active) return;
+    bench_active = true;
+    bench_saved_mode = rgb_matrix_get_mode();
+    bench_saved_enabled = rgb_matrix_is_enabled();
+    bench_mode = RGB_MATRIX_NONE;
+    rgb_matrix_disable_noeeprom();
+    rgb_bench_restart_window();
+    wheel_arm(&bench_timer, RGB_BENCH_BASELINE_MS, rgb_bench_baseline_done);
+}
+
+void rgb_bench_scan(void) {
+    if (!bench_active) return;
+    if (bench_mode != RGB_MATRIX_NONE && !rgb_matrix_is_enabled()) {
+        rgb_bench_finish("aborted, RGB turned off");
+        return;
+    }
+    bench_scans++;
+}
+
+// Called from the indicator callback; returns false while the benchmark owns the LEDs
+bool rgb_bench_frame(uint8_t led_min, uint8_t led_max) {
+    if (!bench_active) return true;
+    if (bench_mode == RGB_MATRIX_NONE || led_max < RGB_MATRIX_LED_COUNT) return false;
+
+    if (++bench_frames == RGB_BENCH_SETTLE) {
+        bench_scans = 0;
+        bench_start = timer_read32();
+    } else if (bench_frames == RGB_BENCH_SETTLE + RGB_BENCH_FRAMES) {
+        uint32_t elapsed_us = timer_elapsed32(bench_start) * 1000;
+        uint32_t idle_us = (uint64_t)bench_scans * bench_baseline_ns / 1000;
+        uint32_t frame_us = elapsed_us > idle_us ? (elapsed_us - idle_us) / RGB_BENCH_FRAMES : 0;
+        uprintf("rgb bench: mode %u: %lu us/frame, %lu ns/scan, %lu scans/frame\n", bench_mode, frame_us, bench_scans ? (uint32_t)((uint64_t)elapsed_us * 1000 / bench_scans) : 0, bench_scans / RGB_BENCH_FRAMES);
+        rgb_bench_next_effect();
+    }
+    return false;
+}
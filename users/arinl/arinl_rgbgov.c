@@ -0,0 +1,127 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// RGB GOVERNOR
+// Animated effects share the CPU with matrix scanning. While a gaming layer is in use, keys are being hammered,
+// or the scan loop runs over budget, the effect is swapped for a static solid frame that costs next to nothing
+// to render. The animation comes back once input has been quiet for RGB_GOV_QUIET_MS, and never while a gaming
+// layer is still on: leaving it starts the quiet time over, so pausing mid-game doesn't flip the effect back.
+// Picking another effect while throttled makes that the one restored and keeps the solid frame until then (picking
+// solid color itself can't be told apart from the throttle, so the saved effect still comes back).
+// The scan period is measured every RGB_GOV_SCAN_WINDOW scans, so a slow effect is caught while a key is held or
+// between presses too. Only scans within RGB_GOV_QUIET_MS of a press count against the budget: with nobody typing
+// a slow scan costs no latency, and throttling then would only flip the effect back and forth.
+#ifndef RGB_GOV_QUIET_MS
+    #define RGB_GOV_QUIET_MS 1500 // no presses for this long restores the animation
+#endif
+#ifndef RGB_GOV_BURST_PRESSES
+    #define RGB_GOV_BURST_PRESSES 8 // presses within RGB_GOV_BURST_MS that count as hammering on any layer
+#endif
+#ifndef RGB_GOV_BURST_MS
+    #define RGB_GOV_BURST_MS 1000
+#endif
+#ifndef RGB_GOV_SCAN_BUDGET_US
+    #define RGB_GOV_SCAN_BUDGET_US 1000 // average scan period above this counts as the effect eating the scan loop
+#endif
+#define RGB_GOV_SCAN_WINDOW 128 // scans per scan period measurement, a power of two
+
+static bool     gov_throttled = false;
+static uint8_t  gov_saved_mode;
+static uint16_t gov_burst_start;
+static uint8_t  gov_burst_count;
+static uint32_t gov_last_press;
+static uint8_t  gov_scans;
+static uint32_t gov_scan_start;
+static uint32_t gov_scan_us;       // average scan period over the last window
+static wheel_timer_t gov_quiet_timer;
+
+uint32_t get_scan_period_us(void) {
+    return gov_scan_us;
+}
+
+bool is_rgb_throttled(void) {
+    return gov_throttled;
+}
+
+static void rgb_governor_restore(void) {
+    if (!gov_throttled) return;
+    gov_throttled = false;
+    wheel_cancel(&gov_quiet_timer);
+    if (rgb_matrix_get_mode() == RGB_MATRIX_SOLID_COLOR) rgb_matrix_mode_noeeprom(gov_saved_mode); // else picked since the last window
+}
+
+static bool rgb_governor_gaming_state(layer_state_t state) {
+    uint8_t layer = get_highest_layer(state);
+    return layer == _FN3 || layer == _FN4;
+}
+
+static void rgb_governor_quiet(wheel_timer_t *timer) {
+    if (rgb_governor_gaming_state(layer_state)) return; // stays static until the gaming layer is left
+    rgb_governor_restore();
+}
+
+static void rgb_governor_throttle(void) {
+    if (!gov_throttled) {
+        gov_saved_mode = rgb_matrix_get_mode();
+        if (gov_saved_mode == RGB_MATRIX_SOLID_COLOR) return; // already as cheap as it gets
+        gov_throttled = true;
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    }
+    wheel_arm(&gov_quiet_timer, RGB_GOV_QUIET_MS, rgb_governor_quiet);
+}
+
+// Called from layer_state_set_user with the new state
+void rgb_governor_layer_change(layer_state_t state) {
+    if (gov_throttled && !rgb_governor_gaming_state(state)) wheel_arm(&gov_quiet_timer, RGB_GOV_QUIET_MS, rgb_governor_quiet);
+}
+
+void rgb_governor_keypress(void) {
+    #ifdef RGB_BENCH_ENABLE
+    if (is_rgb_bench_running()) return;
+    #endif
+    if (TIMER_DIFF_16(timer_read(), gov_burst_start) > RGB_GOV_BURST_MS) {
+        gov_burst_start = timer_read();
+        gov_burst_count = 0;
+    }
+    if (gov_burst_count < UINT8_MAX) gov_burst_count++;
+    gov_last_press = timer_read32();
+
+    if (rgb_governor_gaming_state(layer_state) || gov_burst_count >= RGB_GOV_BURST_PRESSES || gov_scan_us > RGB_GOV_SCAN_BUDGET_US) {
+        rgb_governor_throttle();
+    } else if (gov_throttled) {
+        wheel_arm(&gov_quiet_timer, RGB_GOV_QUIET_MS, rgb_governor_quiet); // still typing, stay static
+    }
+}
+
+void rgb_governor_scan(void) {
+    if (++gov_scans & (RGB_GOV_SCAN_WINDOW - 1)) return;
+    uint32_t now = timer_read32();
+    gov_scan_us = (uint64_t)(now - gov_scan_start) * 1000 / RGB_GOV_SCAN_WINDOW; // a suspend can span hours
+    gov_scan_start = now;
+
+    #ifdef RGB_BENCH_ENABLE
+    if (is_rgb_bench_running()) return;
+    #endif
+    if (gov_throttled && rgb_matrix_get_mode() != RGB_MATRIX_SOLID_COLOR) { // the user picked an effect meanwhile
+        gov_saved_mode = rgb_matrix_get_mode();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    }
+    if (gov_scan_us > RGB_GOV_SCAN_BUDGET_US && timer_elapsed32(gov_last_press) < RGB_GOV_QUIET_MS) rgb_governor_throttle();
+}
@@ -0,0 +1,352 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// PIPELINE SOAK TEST
+// KC_SOAK pushes randomized key and encoder events through the real pipeline (action_exec, so layers, mods and
+// process_record_user all take part, and encoder_update_user) against a stand-in host driver, so nothing reaches
+// the computer. The stand-in answers like a host would for NumLock: each KC_NUM press it receives flips its
+// NumLock LED, so the NumLock sync runs its real round trip. Only matrix positions that resolve to basic keys
+// (lock keys excepted, the soak must not flip the stand-in's NumLock itself), left shift, MO(_FN1) or a macro key
+// on every layer are used; encoder turns with left shift held change layers.
+// KC_SOAK sends events one per timer wheel callback, 5-150 ms apart like real typing, so macros, game inputs and
+// NumLock sync run on the same clock as the events and do their part in between. Shift + KC_SOAK is the volume
+// run: SOAK_FAST_BATCH events back to back on every wheel tick, millions in all, which mostly tests the table and
+// layer handling under load (macro keys pressed faster than they play are dropped whole by the macro queue).
+// Each round prints how long the pipeline took per event and its event rate, releases everything it holds and
+// waits until the macro queue and NumLock sync are idle. Then it checks that no key is owned or registered, no mods are left, only the encoder's
+// layer is on, the stand-in host's NumLock follows _FN2, and nothing is still queued. Violations are printed and
+// cleared so the next round starts clean; the totals come last. Afterwards the real host driver, the selected
+// layer and idle timeout from before the soak (encoder turns on _FN1 change the timeout) and the host's NumLock for
+// them are restored.
+// The soak waits for every key to be released before it starts and stops if a real key is pressed.
+#ifndef SOAK_ROUNDS
+    #define SOAK_ROUNDS 20
+#endif
+#ifndef SOAK_BURST
+    #define SOAK_BURST 200            // events per round, about 15 s
+#endif
+#ifndef SOAK_FAST_ROUNDS
+    #define SOAK_FAST_ROUNDS 100
+#endif
+#ifndef SOAK_FAST_BURST
+    #define SOAK_FAST_BURST 20000     // events per volume run round, 2 million in all
+#endif
+#ifndef SOAK_FAST_BATCH
+    #define SOAK_FAST_BATCH 64        // volume run events per wheel tick
+#endif
+#ifndef SOAK_SETTLE_MS
+    #define SOAK_SETTLE_MS 100        // poll interval while the pipeline drains
+#endif
+#ifndef SOAK_SETTLE_MAX_MS
+    #define SOAK_SETTLE_MAX_MS 5000
+#endif
+
+enum soak_phases {
+    SOAK_IDLE,
+    SOAK_WAIT_RELEASE, // started, waiting for the trigger keys to come up
+    SOAK_BURST_EVENTS, // sending a round's events
+    SOAK_SETTLE        // round sent, draining
+};
+
+static uint8_t soak_phase = SOAK_IDLE;
+static wheel_timer_t soak_timer;
+static host_driver_t *soak_driver;     // the real one, while the stand-in is in
+static uint32_t soak_rng;
+static keypos_t soak_pool[MATRIX_ROWS * MATRIX_COLS];
+static uint8_t soak_pool_count;
+static matrix_row_t soak_down[MATRIX_ROWS];
+static bool soak_fast;                 // volume run
+static uint8_t soak_round;
+static uint16_t soak_sent;             // events sent this round
+static uint32_t soak_round_start_ms;
+static uint16_t soak_settled_ms;
+static bool soak_fn2_seen;             // NumLock is only checked once _FN2 has been entered
+static uint8_t soak_layer;             // selected layer before the soak
+#ifdef IDLE_TIMEOUT_ENABLE
+static uint16_t soak_timeout;          // idle timeout before the soak
+#endif
+static uint32_t soak_events;
+static uint32_t soak_round_cycles;     // pipeline time of this round's events
+static uint32_t soak_round_max_us;
+static uint32_t soak_total_us;
+static uint32_t soak_wall_ms;          // time the rounds took to send
+static uint32_t soak_violations;
+
+static led_t soak_host_leds;           // the stand-in host's LED state
+static bool soak_host_num_down;        // KC_NUM in the last report it got
+
+static uint8_t soak_host_keyboard_leds(void) {
+    return soak_host_leds.raw;
+}
+
+static void soak_host_num(bool down) {
+    if (down && !soak_host_num_down) soak_host_leds.num_lock = !soak_host_leds.num_lock;
+    soak_host_num_down = down;
+}
+
+static void soak_host_send_keyboard(report_keyboard_t *report) {
+    bool down = false;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == KC_NUM) down = true;
+    }
+    soak_host_num(down);
+}
+
+static void soak_host_send_nkro(report_nkro_t *report) {
+    soak_host_num(report->bits[KC_NUM / 8] & (1 << (KC_NUM % 8)));
+}
+
+static void soak_host_send_mouse(report_mouse_t *report) {}
+
+static void soak_host_send_extra(report_extra_t *report) {}
+
+static host_driver_t soak_host = {
+    .keyboard_leds = soak_host_keyboard_leds,
+    .send_keyboard = soak_host_send_keyboard,
+    .send_nkro     = soak_host_send_nkro,
+    .send_mouse    = soak_host_send_mouse,
+    .send_extra    = soak_host_send_extra
+};
+
+static uint32_t soak_random(void) { // xorshift32
+    soak_rng ^= soak_rng << 13;
+    soak_rng ^= soak_rng >> 17;
+    soak_rng ^= soak_rng << 5;
+    return soak_rng;
+}
+
+// Keys the soak may press: nothing that writes EEPROM, reboots, changes RGB settings or toggles a host lock
+static bool soak_safe_keycode(uint16_t keycode) {
+    if (keycode == KC_NUM || keycode == KC_CAPS || keycode == KC_SCRL) return false;
+    if (keycode >= KC_LOCKING_CAPS_LOCK && keycode <= KC_LOCKING_SCROLL_LOCK) return false;
+    if (keycode == KC_NO || keycode == KC_TRNS || keycode == KC_LSFT || keycode == MO(_FN1)) return true;
+    if (keycode >= KC_MCRO1 && keycode <= KC_MCRO4) return true;
+    return IS_BASIC_KEYCODE(keycode);
+}
+
+static void soak_build_pool(void) {
+    soak_pool_count = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t pos = { .row = row, .col = col };
+            bool safe = keymap_key_to_keycode(0, pos) != KC_NO;
+            for (uint8_t layer = 0; layer <= _FN4 && safe; layer++) safe = soak_safe_keycode(keymap_key_to_keycode(layer, pos));
+            if (safe) soak_pool[soak_pool_count++] = pos;
+        }
+    }
+}
+
+static bool soak_matrix_busy(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) return true;
+    }
+    return false;
+}
+
+static void soak_event(keypos_t pos, bool pressed) {
+    action_exec((keyevent_t){ .key = pos, .pressed = pressed, .time = timer_read() | 1, .type = KEY_EVENT }); // time 0 means no event
+    soak_down[pos.row] ^= (matrix_row_t)1 << pos.col;
+}
+
+// Sends one random event and times the pipeline handling it
+static uint16_t soak_burst(void) {
+    return soak_fast ? SOAK_FAST_BURST : SOAK_BURST;
+}
+
+static void soak_random_event(void) {
+    uint32_t r = soak_random();
+    uint32_t start = cycle_read();
+    #ifdef ENCODER_ENABLE
+    if (r % 16 < 2) {
+        encoder_update_user(0, r & 0x100);
+    } else
+    #endif
+    {
+        keypos_t pos = soak_pool[(r >> 8) % soak_pool_count];
+        soak_event(pos, !(soak_down[pos.row] & ((matrix_row_t)1 << pos.col)));
+    }
+    uint32_t cycles = cycle_read() - start;
+    soak_round_cycles += cycles;
+    if (cycles_to_us(cycles) > soak_round_max_us) soak_round_max_us = cycles_to_us(cycles);
+    if (IS_LAYER_ON(_FN2)) soak_fn2_seen = true;
+}
+
+static void soak_release(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (soak_down[row] & ((matrix_row_t)1 << col)) soak_event((keypos_t){ .row = row, .col = col }, false);
+        }
+    }
+}
+
+static uint8_t soak_check(void) {
+    uint8_t bad = 0;
+    if (!key_owner_is_idle()) {
+        uprintf("soak %u: keys still owned or registered\n", soak_round);
+        bad++;
+    }
+    if (get_mods() || get_weak_mods()) {
+        uprintf("soak %u: mods %02X weak %02X left on\n", soak_round, get_mods(), get_weak_mods());
+        bad++;
+    }
+    #ifdef ENCODER_ENABLE
+    layer_state_t expected = (layer_state_t)1 << get_selected_layer();
+    #else
+    layer_state_t expected = 1;
+    #endif
+    if (layer_state & ~expected) {
+        uprintf("soak %u: layers %08lX on, expected %08lX\n", soak_round, (uint32_t)layer_state, (uint32_t)expected);
+        layer_state_set(layer_state & expected);
+        bad++;
+    }
+    if (soak_fn2_seen && soak_host_leds.num_lock != IS_LAYER_ON(_FN2)) {
+        uprintf("soak %u: host NumLock %u with _FN2 %u\n", soak_round, soak_host_leds.num_lock, IS_LAYER_ON(_FN2));
+        bad++;
+    }
+    if (macro_is_playing() || macro_is_speculating()) {
+        uprintf("soak %u: macro still queued\n", soak_round);
+        bad++;
+    }
+    if (bad) {
+        clear_keyboard();
+        key_owner_clear();
+    }
+    return bad;
+}
+
+static void soak_finish(const char *reason) {
+    wheel_cancel(&soak_timer);
+    if (soak_phase == SOAK_BURST_EVENTS) soak_release();
+    if (soak_phase != SOAK_WAIT_RELEASE) {
+        host_set_driver(soak_driver);
+        #ifdef ENCODER_ENABLE
+        set_selected_layer(soak_layer);
+        #else
+        layer_clear();
+        #endif
+        #ifdef IDLE_TIMEOUT_ENABLE
+        timeout_set_threshold(soak_timeout);
+        #endif
+        activate_numlock(IS_LAYER_ON(_FN2)); // the host never saw the stand-in's NumLock toggles
+    }
+    soak_phase = SOAK_IDLE;
+    uprintf("soak %s: %lu events, avg %lu us, %lu/s in the pipeline, %lu/s sent, %lu violations\n", reason, soak_events,
+            soak_events ? soak_total_us / soak_events : 0, soak_total_us ? (uint32_t)((uint64_t)soak_events * 1000000 / soak_total_us) : 0,
+            soak_wall_ms ? (uint32_t)((uint64_t)soak_events * 1000 / soak_wall_ms) : 0, soak_violations);
+}
+
+static void soak_step(wheel_timer_t *timer);
+
+static void soak_round_start(void) {
+    soak_phase = SOAK_BURST_EVENTS;
+    soak_sent = 0;
+    soak_round_cycles = 0;
+    soak_round_max_us = 0;
+    soak_round_start_ms = timer_read32();
+    wheel_arm(&soak_timer, soak_fast ? 1 : 5 + soak_random() % 146, soak_step);
+}
+
+static void soak_step(wheel_timer_t *timer) {
+    switch (soak_phase) {
+    case SOAK_WAIT_RELEASE:
+        if (soak_matrix_busy()) {
+            wheel_arm(timer, SOAK_SETTLE_MS, soak_step);
+            return;
+        }
+        soak_build_pool();
+        if (!soak_pool_count) {
+            soak_finish("aborted, no safe keys");
+            return;
+        }
+        soak_driver = host_get_driver();
+        soak_host_leds = host_keyboard_led_state(); // pick up where the real host is
+        soak_host_num_down = false;
+        #ifdef ENCODER_ENABLE
+        soak_layer = get_selected_layer();
+        #endif
+        #ifdef IDLE_TIMEOUT_ENABLE
+        soak_timeout = get_timeout_threshold();
+        #endif
+        host_set_driver(&soak_host); // nothing below reaches the host
+        soak_round_start();
+        break;
+    case SOAK_BURST_EVENTS:
+        if (soak_matrix_busy()) {
+            soak_finish("aborted, key pressed");
+            return;
+        }
+        for (uint8_t i = soak_fast ? SOAK_FAST_BATCH : 1; i && soak_sent < soak_burst(); i--, soak_sent++) soak_random_event();
+        if (soak_sent < soak_burst()) {
+            wheel_arm(timer, soak_fast ? 1 : 5 + soak_random() % 146, soak_step);
+            return;
+        }
+        soak_release();
+        uint32_t round_us = cycles_to_us(soak_round_cycles);
+        soak_events += soak_sent;
+        soak_total_us += round_us;
+        soak_wall_ms += timer_elapsed32(soak_round_start_ms);
+        uprintf("soak %u: %u events, avg %lu us, max %lu us, %lu/s\n", soak_round, soak_sent, round_us / soak_sent, soak_round_max_us,
+                round_us ? (uint32_t)((uint64_t)soak_sent * 1000000 / round_us) : 0);
+        soak_phase = SOAK_SETTLE;
+        soak_settled_ms = 0;
+        wheel_arm(timer, SOAK_SETTLE_MS, soak_step);
+        break;
+    case SOAK_SETTLE:
+        if (soak_matrix_busy()) {
+            soak_finish("aborted, key pressed");
+            return;
+        }
+        if ((macro_is_playing() || numlock_is_busy()) && soak_settled_ms < SOAK_SETTLE_MAX_MS) {
+            soak_settled_ms += SOAK_SETTLE_MS;
+            wheel_arm(timer, SOAK_SETTLE_MS, soak_step);
+            return;
+        }
+        soak_violations += soak_check();
+        if (++soak_round >= (soak_fast ? SOAK_FAST_ROUNDS : SOAK_ROUNDS)) {
+            soak_finish("done");
+            return;
+        }
+        soak_round_start();
+        break;
+    }
+}
+
+bool soak_is_running(void) {
+    return soak_phase != SOAK_IDLE;
+}
+
+// KC_SOAK starts a soak (the volume run when fast), or stops the one running
+void soak_start(bool fast) {
+    if (soak_phase != SOAK_IDLE) { // while running the press itself is muted, but it still lands here
+        soak_finish("stopped");
+        return;
+    }
+    soak_rng = timer_read32() | 1;
+    memset(soak_down, 0, sizeof(soak_down));
+    soak_fast = fast;
+    soak_round = 0;
+    soak_fn2_seen = false;
+    soak_events = 0;
+    soak_total_us = 0;
+    soak_wall_ms = 0;
+    soak_violations = 0;
+    soak_phase = SOAK_WAIT_RELEASE;
+    wheel_arm(&soak_timer, SOAK_SETTLE_MS, soak_step);
+}
@@ -0,0 +1,119 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// TURBO
+// Hold TB_SET and tap a key to mark/unmark it as a turbo key. On the gaming layers a held turbo key is toggled
+// at turbo_rate taps per second. Every key runs on its own wheel timer, so phases stay independent.
+typedef struct {
+    wheel_timer_t timer;   // must stay first, the wheel callback casts back to the slot
+    uint8_t       keycode; // KC_NO when the slot is free
+    bool          held;    // physically held and turbo running
+    bool          down;    // turbo currently holds the key
+} turbo_slot_t;
+
+static turbo_slot_t turbo_slots[TURBO_MAX_KEYS];
+static uint8_t turbo_rate = TURBO_RATE_DEFAULT;
+static bool turbo_selecting = false;
+
+uint8_t get_turbo_rate(void) {
+    return turbo_rate;
+}
+
+void turbo_update_rate(bool increase) {
+    if (increase && turbo_rate < TURBO_RATE_MAX) turbo_rate++;
+    if (!increase && turbo_rate > TURBO_RATE_MIN) turbo_rate--;
+}
+
+static bool turbo_layer_active(void) {
+    uint8_t layer = get_highest_layer(layer_state);
+    return layer == _FN3 || layer == _FN4;
+}
+
+static uint16_t turbo_half_period(void) {
+    return 500 / turbo_rate;
+}
+
+static void turbo_toggle(wheel_timer_t *timer) {
+    turbo_slot_t *slot = (turbo_slot_t *)timer;
+    slot->down = !slot->down;
+    key_owner_tap(slot->keycode, KO_TURBO, slot->down);
+    wheel_arm(&slot->timer, turbo_half_period(), turbo_toggle);
+}
+
+static void turbo_stop(turbo_slot_t *slot) {
+    wheel_cancel(&slot->timer);
+    if (slot->down) key_owner_tap(slot->keycode, KO_TURBO, false);
+    slot->held = false;
+    slot->down = false;
+}
+
+static turbo_slot_t *turbo_find(uint8_t keycode) {
+    for (uint8_t i = 0; i < TURBO_MAX_KEYS; i++) {
+        if (turbo_slots[i].keycode == keycode) return &turbo_slots[i];
+    }
+    return NULL;
+}
+
+// Marks the key as turbo, or unmarks it if it already was
+static void turbo_select(uint8_t keycode) {
+    turbo_slot_t *slot = turbo_find(keycode);
+    if (slot) {
+        turbo_stop(slot);
+        slot->keycode = KC_NO;
+    } else if ((slot = turbo_find(KC_NO))) {
+        slot->keycode = keycode;
+    }
+}
+
+bool process_turbo(uint16_t keycode, keyrecord_t *record) {
+    switch (keycode) {
+    case TB_SET:
+        turbo_selecting = record->event.pressed;
+        return false;
+    case TB_RATU:
+    case TB_RATD:
+        if (record->event.pressed) turbo_update_rate(keycode == TB_RATU);
+        return false;
+    }
+
+    if (!IS_BASIC_KEYCODE(keycode)) return true;
+
+    if (turbo_selecting) {
+        if (record->event.pressed) turbo_select(keycode);
+        return false;
+    }
+
+    turbo_slot_t *slot = turbo_find(keycode);
+    if (!slot) return true;
+
+    if (record->event.pressed) {
+        if (!turbo_layer_active()) return true;
+        slot->held = true;
+        slot->down = true;
+        key_owner_tap(slot->keycode, KO_TURBO, true);
+        wheel_arm(&slot->timer, turbo_half_period(), turbo_toggle);
+        return false;
+    }
+    if (slot->held) { // release follows the press, even if the layer changed in between
+        turbo_stop(slot);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,133 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+#include "rgb_matrix_geometry.h"
+
+// USAGE STATS
+// Counts presses per matrix position (saturating at 65535) and the time spent on each layer, to see which keys
+// and layers carry the load when tuning debounce, layer placement and macro bindings. A press costs one
+// increment and a wheel re-arm; a layer change adds the time since the last mark to the layer it leaves.
+// Layer time only runs while keys are being pressed: once USAGE_IDLE_MS pass without a press the open interval is
+// dropped, and that same idle point checkpoints the counters to the user datablock right after the macro
+// recording, so flash is only written when nobody is playing.
+// Nothing is counted while a soak test runs, its presses and layer changes aren't the player's.
+// KC_USAGE prints the table to the console, named after the LEDs in rgb_matrix_geometry.h; with shift held it
+// clears the counters instead.
+#ifndef USAGE_IDLE_MS
+    #define USAGE_IDLE_MS 60000
+#endif
+#define USAGE_MAGIC 0xA51E
+
+typedef struct {
+    uint16_t magic;
+    uint16_t reserved;
+    uint32_t dwell_ms[_FN4 + 1];
+    uint16_t presses[MATRIX_ROWS][MATRIX_COLS];
+} usage_store_t;
+
+_Static_assert(USAGE_DATABLOCK_OFFSET + sizeof(usage_store_t) <= EECONFIG_USER_DATA_SIZE, "EECONFIG_USER_DATA_SIZE too small for the usage stats");
+_Static_assert(USAGE_DATABLOCK_OFFSET + sizeof(usage_store_t) <= EEBENCH_DATABLOCK_OFFSET, "usage stats overlap the EEPROM benchmark's scratch region in the datablock");
+
+#define LED_NAME(name, x, y) #name,
+static const char *const usage_led_names[] = { LED_POINTS(LED_NAME) };
+
+static usage_store_t usage;
+static uint8_t usage_layer = 0;
+static uint32_t usage_mark;           // start of the open layer time interval
+static bool usage_active = false;     // a key was pressed within USAGE_IDLE_MS
+static bool usage_dirty = false;
+static wheel_timer_t usage_timer;
+
+static void usage_add_dwell(uint32_t now) {
+    uint32_t elapsed = now - usage_mark;
+    uint32_t *dwell = &usage.dwell_ms[usage_layer];
+    *dwell = *dwell > UINT32_MAX - elapsed ? UINT32_MAX : *dwell + elapsed;
+    usage_mark = now;
+}
+
+// Called from the boot config stage
+void usage_init(void) {
+    eeconfig_read_user_datablock(&usage, USAGE_DATABLOCK_OFFSET, sizeof(usage));
+    if (usage.magic != USAGE_MAGIC) { // blank datablock or another layout
+        memset(&usage, 0, sizeof(usage));
+        usage.magic = USAGE_MAGIC;
+    }
+}
+
+static void usage_checkpoint(void) {
+    eeconfig_update_user_datablock(&usage, USAGE_DATABLOCK_OFFSET, sizeof(usage));
+    usage_dirty = false;
+}
+
+static void usage_idle(wheel_timer_t *timer) {
+    usage_active = false; // the time since the last press was idle, not play
+    if (usage_dirty) usage_checkpoint();
+}
+
+void usage_count_press(keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) return; // encoder and combo events
+    #ifdef SOAK_TEST_ENABLE
+    if (soak_is_running()) return;
+    #endif
+    uint16_t *presses = &usage.presses[key.row][key.col];
+    if (*presses < UINT16_MAX) (*presses)++;
+
+    uint32_t now = timer_read32();
+    if (usage_active) {
+        usage_add_dwell(now);
+    } else {
+        usage_mark = now;
+        usage_active = true;
+    }
+    usage_dirty = true;
+    wheel_arm(&usage_timer, USAGE_IDLE_MS, usage_idle);
+}
+
+// Called from layer_state_set_user with the new highest layer
+void usage_layer_change(uint8_t layer) {
+    if (layer > _FN4) layer = _FN4;
+    if (layer == usage_layer) return;
+    #ifdef SOAK_TEST_ENABLE
+    if (soak_is_running()) usage_active = false; // drop the open interval, the soak's layer time isn't play
+    #endif
+    if (usage_active) usage_add_dwell(timer_read32());
+    usage_layer = layer;
+}
+
+void usage_print(void) {
+    uprintf("usage: key presses\n");
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led == NO_LED || !usage.presses[row][col]) continue;
+            uprintf("  %-5s %5u\n", usage_led_names[led], usage.presses[row][col]);
+        }
+    }
+    uprintf("usage: layer seconds\n");
+    for (uint8_t layer = 0; layer <= _FN4; layer++) {
+        uprintf("  %u %lu\n", layer, usage.dwell_ms[layer] / 1000);
+    }
+}
+
+void usage_clear(void) {
+    memset(usage.dwell_ms, 0, sizeof(usage.dwell_ms));
+    memset(usage.presses, 0, sizeof(usage.presses));
+    usage_active = false;
+    usage_checkpoint();
+}
@@ -0,0 +1,99 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include QMK_KEYBOARD_H
+
+#include "arinl.h"
+
+// TIMER WHEEL
+// Hashed timer wheel with 1ms ticks. Timers are owned by the caller (no allocation), arm/cancel are O(1) list
+// operations and wheel_task() returns straight away while nothing is armed, so idle scans pay nothing.
+#ifndef TIMER_WHEEL_SLOTS
+    #define TIMER_WHEEL_SLOTS 64 // must be a power of two
+#endif
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+
+static wheel_timer_t *wheel_slots[TIMER_WHEEL_SLOTS];
+static wheel_timer_t *wheel_expired;
+static uint16_t wheel_now = 0;     // last tick processed
+static uint8_t  wheel_pending = 0; // number of armed timers
+static bool     wheel_running = false;
+
+static void wheel_link(wheel_timer_t **head, wheel_timer_t *timer) {
+    timer->next = *head;
+    if (timer->next) timer->next->pprev = &timer->next;
+    *head = timer;
+    timer->pprev = head;
+}
+
+static void wheel_unlink(wheel_timer_t *timer) {
+    *timer->pprev = timer->next;
+    if (timer->next) timer->next->pprev = timer->pprev;
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+bool wheel_is_armed(const wheel_timer_t *timer) {
+    return timer->pprev != NULL;
+}
+
+void wheel_arm(wheel_timer_t *timer, uint16_t delay_ms, wheel_callback_t callback) {
+    if (wheel_is_armed(timer)) {
+        wheel_unlink(timer);
+    } else {
+        if (wheel_pending == 0 && !wheel_running) wheel_now = timer_read(); // wheel was idle, catch up for free
+        wheel_pending++;
+    }
+    if (delay_ms == 0) delay_ms = 1; // never fire inside the tick that armed it
+    timer->callback = callback;
+    timer->rounds = (delay_ms - 1) / TIMER_WHEEL_SLOTS;
+    wheel_link(&wheel_slots[(uint16_t)(wheel_now + delay_ms) & TIMER_WHEEL_MASK], timer);
+}
+
+void wheel_cancel(wheel_timer_t *timer) {
+    if (!wheel_is_armed(timer)) return;
+    wheel_unlink(timer);
+    wheel_pending--;
+}
+
+void wheel_task(void) {
+    if (wheel_pending == 0) return;
+
+    uint16_t ticks = TIMER_DIFF_16(timer_read(), wheel_now);
+    wheel_running = true;
+    while (ticks-- && wheel_pending) {
+        wheel_now++;
+        // collect what is due first, so callbacks are free to arm or cancel anything
+        wheel_timer_t *timer = wheel_slots[wheel_now & TIMER_WHEEL_MASK];
+        while (timer) {
+            wheel_timer_t *next = timer->next;
+            if (timer->rounds) {
+                timer->rounds--;
+            } else {
+                wheel_unlink(timer);
+                wheel_link(&wheel_expired, timer);
+            }
+            timer = next;
+        }
+        while (wheel_expired) {
+            timer = wheel_expired;
+            wheel_unlink(timer);
+            wheel_pending--;
+            timer->callback(timer);
+        }
+    }
+    wheel_running = false;
+}
@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+
+# Flash cost of each RGB effect the arinl keymap keeps, to go with the CPU times RGB_BNCH prints on the device.
+# Builds a scratch copy of the keymap as is, then once per effect with that effect's ENABLE_RGB_MATRIX_* turned
+# off, and prints how many bytes of flash each effect costs. The userspace effects (RGB_MATRIX_CUSTOM_USER) are
+# left out together and reported as one group. Run from the userspace root once `qmk setup` is done:
+#   users/arinl/rgb_effect_sizes.sh
+
+set -eEuo pipefail
+
+keyboard=gmmk/pro/rev1/ansi
+keymaps="keyboards/$keyboard/keymaps"
+scratch=arinl_fxsize
+qmk_home=$(qmk config -ro user.qmk_home | cut -d= -f2)
+elf="$qmk_home/.build/${keyboard//\//_}_$scratch.elf"
+
+trap 'rm -rf "$keymaps/$scratch"' EXIT
+
+# Fresh copy of the arinl keymap with the given lines appended to its config.h
+scratch_keymap() {
+    rm -rf "$keymaps/$scratch"
+    cp -r "$keymaps/arinl" "$keymaps/$scratch"
+    printf '%s\n' "$@" >> "$keymaps/$scratch/config.h"
+}
+
+# Flash used by the scratch keymap (.text + .data)
+flash_size() {
+    qmk compile -kb "$keyboard" -km "$scratch" "$@" > /dev/null
+    arm-none-eabi-size "$elf" | awk 'NR == 2 { print $1 + $2 }'
+}
+
+scratch_keymap
+full=$(flash_size)
+echo "full build: $full bytes"
+
+# Effects still on are the ones whose #undef is commented out in the keymap's config.h
+for effect in $(sed -n 's@^[[:space:]]*//#undef ENABLE_RGB_MATRIX_\([A-Z_]*\).*@\1@p' "$keymaps/arinl/config.h"); do
+    scratch_keymap "#undef ENABLE_RGB_MATRIX_$effect"
+    printf '%-28s %6d bytes\n' "$effect" $((full - $(flash_size)))
+done
+
+scratch_keymap "#undef RGB_MATRIX_DEFAULT_MODE" "#define RGB_MATRIX_DEFAULT_MODE RGB_MATRIX_SOLID_COLOR"
+printf '%-28s %6d bytes\n' "userspace effects" $((full - $(flash_size -e RGB_MATRIX_CUSTOM_USER=no)))
@@ -0,0 +1,125 @@
+/* Copyright 2024 arinl <arinl@tuta.io>
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// GMMK Pro ANSI LED positions on QMK's 224 x 64 grid, one LED_POINT(name, x, y) per LED in led_location_map
+// order (see rgb_matrix_map.h). It lives in the userspace because the userspace effects in rgb_matrix_user.inc,
+// the frame dump and the usage stats expand this list, whichever keymap is built; on another board the
+// _Static_asserts against RGB_MATRIX_LED_COUNT in those files flag the mismatch. This header holds no
+// definitions, so unlike rgb_matrix_map.h it is safe to include from the RGB matrix translation unit.
+#define LED_CENTER_X 112
+#define LED_CENTER_Y 32
+
+#define LED_POINTS(LED_POINT) \
+    LED_POINT(ESC, 0, 0)      /*  0 */ \
+    LED_POINT(GRV, 0, 15)     /*  1 */ \
+    LED_POINT(TAB, 4, 26)     /*  2 */ \
+    LED_POINT(CAPS, 5, 38)    /*  3 */ \
+    LED_POINT(LSFT, 9, 49)    /*  4 */ \
+    LED_POINT(LCTL, 2, 61)    /*  5 */ \
+    LED_POINT(F1, 18, 0)      /*  6 */ \
+    LED_POINT(1, 14, 15)      /*  7 */ \
+    LED_POINT(Q, 22, 26)      /*  8 */ \
+    LED_POINT(A, 25, 38)      /*  9 */ \
+    LED_POINT(Z, 33, 49)      /* 10 */ \
+    LED_POINT(LWIN, 20, 61)   /* 11 */ \
+    LED_POINT(F2, 33, 0)      /* 12 */ \
+    LED_POINT(2, 29, 15)      /* 13 */ \
+    LED_POINT(W, 36, 26)      /* 14 */ \
+    LED_POINT(S, 40, 38)      /* 15 */ \
+    LED_POINT(X, 47, 49)      /* 16 */ \
+    LED_POINT(LALT, 38, 61)   /* 17 */ \
+    LED_POINT(F3, 47, 0)      /* 18 */ \
+    LED_POINT(3, 43, 15)      /* 19 */ \
+    LED_POINT(E, 51, 26)      /* 20 */ \
+    LED_POINT(D, 54, 38)      /* 21 */ \
+    LED_POINT(C, 61, 49)      /* 22 */ \
+    LED_POINT(F4, 61, 0)      /* 23 */ \
+    LED_POINT(4, 58, 15)      /* 24 */ \
+    LED_POINT(R, 65, 26)      /* 25 */ \
+    LED_POINT(F, 69, 38)      /* 26 */ \
+    LED_POINT(V, 76, 49)      /* 27 */ \
+    LED_POINT(F5, 79, 0)      /* 28 */ \
+    LED_POINT(5, 72, 15)      /* 29 */ \
+    LED_POINT(T, 79, 26)      /* 30 */ \
+    LED_POINT(G, 83, 38)      /* 31 */ \
+    LED_POINT(B, 90, 49)      /* 32 */ \
+    LED_POINT(SPC, 92, 61)    /* 33 */ \
+    LED_POINT(F6, 94, 0)      /* 34 */ \
+    LED_POINT(6, 87, 15)      /* 35 */ \
+    LED_POINT(Y, 94, 26)      /* 36 */ \
+    LED_POINT(H, 98, 38)      /* 37 */ \
+    LED_POINT(N, 105, 49)     /* 38 */ \
+    LED_POINT(F7, 108, 0)     /* 39 */ \
+    LED_POINT(7, 101, 15)     /* 40 */ \
+    LED_POINT(U, 108, 26)     /* 41 */ \
+    LED_POINT(J, 112, 38)     /* 42 */ \
+    LED_POINT(M, 119, 49)     /* 43 */ \
+    LED_POINT(F8, 123, 0)     /* 44 */ \
+    LED_POINT(8, 116, 15)     /* 45 */ \
+    LED_POINT(I, 123, 26)     /* 46 */ \
+    LED_POINT(K, 126, 38)     /* 47 */ \
+    LED_POINT(COMM, 134, 49)  /* 48 */ \
+    LED_POINT(RALT, 145, 61)  /* 49 */ \
+    LED_POINT(F9, 141, 0)     /* 50 */ \
+    LED_POINT(9, 130, 15)     /* 51 */ \
+    LED_POINT(O, 137, 26)     /* 52 */ \
+    LED_POINT(L, 141, 38)     /* 53 */ \
+    LED_POINT(DOT, 148, 49)   /* 54 */ \
+    LED_POINT(FN, 159, 61)    /* 55 */ \
+    LED_POINT(F10, 155, 0)    /* 56 */ \
+    LED_POINT(0, 145, 15)     /* 57 */ \
+    LED_POINT(P, 152, 26)     /* 58 */ \
+    LED_POINT(SCLN, 155, 38)  /* 59 */ \
+    LED_POINT(SLSH, 163, 49)  /* 60 */ \
+    LED_POINT(F11, 170, 0)    /* 61 */ \
+    LED_POINT(MINS, 159, 15)  /* 62 */ \
+    LED_POINT(LBRC, 166, 26)  /* 63 */ \
+    LED_POINT(QUOT, 170, 38)  /* 64 */ \
+    LED_POINT(RCTL, 173, 61)  /* 65 */ \
+    LED_POINT(F12, 184, 0)    /* 66 */ \
+    LED_POINT(L1, 0, 0)       /* 67 */ \
+    LED_POINT(R1, 224, 0)     /* 68 */ \
+    LED_POINT(INS, 202, 0)    /* 69 */ \
+    LED_POINT(L2, 0, 9)       /* 70 */ \
+    LED_POINT(R2, 224, 9)     /* 71 */ \
+    LED_POINT(DEL, 224, 15)   /* 72 */ \
+    LED_POINT(L3, 0, 18)      /* 73 */ \
+    LED_POINT(R3, 224, 18)    /* 74 */ \
+    LED_POINT(PGUP, 224, 26)  /* 75 */ \
+    LED_POINT(L4, 0, 27)      /* 76 */ \
+    LED_POINT(R4, 224, 27)    /* 77 */ \
+    LED_POINT(EQL, 173, 15)   /* 78 */ \
+    LED_POINT(RIGHT, 220, 64) /* 79 */ \
+    LED_POINT(L5, 0, 37)      /* 80 */ \
+    LED_POINT(R5, 224, 37)    /* 81 */ \
+    LED_POINT(END, 224, 49)   /* 82 */ \
+    LED_POINT(L6, 0, 46)      /* 83 */ \
+    LED_POINT(R6, 224, 46)    /* 84 */ \
+    LED_POINT(BSPC, 195, 15)  /* 85 */ \
+    LED_POINT(PGDN, 224, 38)  /* 86 */ \
+    LED_POINT(L7, 0, 55)      /* 87 */ \
+    LED_POINT(R7, 224, 55)    /* 88 */ \
+    LED_POINT(RBRC, 181, 26)  /* 89 */ \
+    LED_POINT(RSFT, 182, 49)  /* 90 */ \
+    LED_POINT(L8, 0, 64)      /* 91 */ \
+    LED_POINT(R8, 224, 64)    /* 92 */ \
+    LED_POINT(BSLS, 199, 26)  /* 93 */ \
+    LED_POINT(UP, 206, 52)    /* 94 */ \
+    LED_POINT(LEFT, 191, 64)  /* 95 */ \
+    LED_POINT(ENT, 193, 38)   /* 96 */ \
+    LED_POINT(DOWN, 206, 64)  /* 97 */
@@ -15,6 +15,9 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+// GMMK Pro ANSI LED names, lists and colors, shared by the keymaps built on this userspace. It defines variables,
+// so only a keymap.c includes it.
+
 #ifdef RGB_MATRIX_ENABLE
 
 //Define variables for Game
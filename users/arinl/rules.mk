@@ -1,4 +1,4 @@
-SRC += arinl.c
+SRC += arinl.c arinl_wheel.c arinl_macro.c arinl_numlock.c arinl_boot.c arinl_keyown.c arinl_cycles.c
 ifdef ENCODER_ENABLE
 	# include encoder related code when enabled
 	ifeq ($(strip $(ENCODER_DEFAULTACTIONS_ENABLE)), yes)
@@ -15,3 +15,47 @@ endif
 ifeq ($(strip $(INVERT_NUMLOCK_INDICATOR)), yes)
     OPT_DEFS += -DINVERT_NUMLOCK_INDICATOR
 endif
+ifeq ($(strip $(TURBO_ENABLE)), yes)
+    OPT_DEFS += -DTURBO_ENABLE
+    SRC += arinl_turbo.c
+endif
+ifeq ($(strip $(GAME_INPUT_ENABLE)), yes)
+    OPT_DEFS += -DGAME_INPUT_ENABLE
+    SRC += arinl_gameinput.c
+endif
+ifeq ($(strip $(MACRO_RECORDER_ENABLE)), yes)
+    OPT_DEFS += -DMACRO_RECORDER_ENABLE
+    SRC += arinl_recorder.c
+endif
+ifeq ($(strip $(RGB_BENCH_ENABLE)), yes)
+    OPT_DEFS += -DRGB_BENCH_ENABLE
+    SRC += arinl_rgbbench.c
+endif
+ifeq ($(strip $(RGB_FRAME_DUMP_ENABLE)), yes)
+    OPT_DEFS += -DRGB_FRAME_DUMP_ENABLE
+    SRC += arinl_framedump.c
+    # the dump sees every LED write, the effect's included, at the AW20216S driver
+    EXTRALDFLAGS += -Wl,--wrap=aw20216s_set_color -Wl,--wrap=aw20216s_set_color_all
+    # --wrap can't redirect calls LTO resolves inside its own partition, so the dump build links without it
+    LTO_ENABLE = no
+endif
+ifeq ($(strip $(USAGE_STATS_ENABLE)), yes)
+    OPT_DEFS += -DUSAGE_STATS_ENABLE
+    SRC += arinl_usage.c
+endif
+ifeq ($(strip $(EEPROM_BENCH_ENABLE)), yes)
+    OPT_DEFS += -DEEPROM_BENCH_ENABLE
+    SRC += arinl_eebench.c
+endif
+ifeq ($(strip $(SOAK_TEST_ENABLE)), yes)
+    OPT_DEFS += -DSOAK_TEST_ENABLE
+    SRC += arinl_soak.c
+endif
+ifeq ($(strip $(RGB_POWER_LIMIT_ENABLE)), yes)
+    OPT_DEFS += -DRGB_POWER_LIMIT_ENABLE
+    SRC += arinl_power.c
+endif
+ifeq ($(strip $(RGB_GOVERNOR_ENABLE)), yes)
+    OPT_DEFS += -DRGB_GOVERNOR_ENABLE
+    SRC += arinl_rgbgov.c
+endif